@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_chat_participants.h"
 
 #include "apiwrap.h"
+#include "api/api_hash.h"
 #include "boxes/add_contact_box.h" // ShowAddParticipantsError
 #include "boxes/peers/add_participants_box.h" // ChatInviteForbidden
 #include "data/data_changes.h"
@@ -38,6 +39,17 @@ constexpr auto kMaxUsersPerInvite = 100;
 // that was added to this chat.
 constexpr auto kForwardMessagesOnAdd = 100;
 
+[[nodiscard]] uint64 CountParticipantsHash(
+		int availableCount,
+		Members list) {
+	auto result = HashInit();
+	HashUpdate(result, uint64(availableCount));
+	for (const auto &participant : list) {
+		HashUpdate(result, peerToUser(participant.id()).bare);
+	}
+	return HashFinalize(result);
+}
+
 std::vector<ChatParticipant> ParseList(
 		const ChatParticipants::TLMembers &data,
 		not_null<PeerData*> peer) {
@@ -401,8 +413,13 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 		return;
 	}
 
+	// Keep the last received list, so that when it didn't change on
+	// the server we re-apply it instead of receiving it once again.
 	const auto offset = 0;
-	const auto participantsHash = uint64(0);
+	const auto i = _lastLists.find(channel);
+	const auto participantsHash = (i != end(_lastLists))
+		? i->second.hash
+		: uint64(0);
 	const auto requestId = _api.request(MTPchannels_GetParticipants(
 		channel->inputChannel,
 		MTP_channelParticipantsRecent(),
@@ -413,11 +430,23 @@ void ChatParticipants::requestLast(not_null<ChannelData*> channel) {
 		_participantsRequests.remove(channel);
 
 		result.match([&](const MTPDchannels_channelParticipants &data) {
-			const auto &[availableCount, list] = Parse(channel, data);
-			ApplyLastList(channel, availableCount, list);
-		}, [](const MTPDchannels_channelParticipantsNotModified &) {
-			LOG(("API Error: "
-				"channels.channelParticipantsNotModified received!"));
+			auto parsed = Parse(channel, data);
+			ApplyLastList(channel, parsed.availableCount, parsed.list);
+			_lastLists[channel] = LastList{
+				.hash = CountParticipantsHash(
+					parsed.availableCount,
+					parsed.list),
+				.availableCount = parsed.availableCount,
+				.list = parsed.list,
+			};
+		}, [&](const MTPDchannels_channelParticipantsNotModified &) {
+			const auto j = _lastLists.find(channel);
+			if (j == end(_lastLists)) {
+				LOG(("API Error: "
+					"channels.channelParticipantsNotModified received!"));
+				return;
+			}
+			ApplyLastList(channel, j->second.availableCount, j->second.list);
 		});
 	}).fail([this, channel] {
 		_participantsRequests.remove(channel);
@@ -154,6 +154,11 @@ private:
 		Channels channels;
 		mtpRequestId requestId = 0;
 	};
+	struct LastList {
+		uint64 hash = 0;
+		int availableCount = 0;
+		std::vector<ChatParticipant> list;
+	};
 
 	const not_null<Main::Session*> _session;
 
@@ -164,6 +169,7 @@ private:
 	PeerRequests _participantsRequests;
 	PeerRequests _botsRequests;
 	PeerRequests _adminsRequests;
+	base::flat_map<not_null<ChannelData*>, LastList> _lastLists;
 	base::DelayedCallTimer _participantsCountRequestTimer;
 
 	struct {
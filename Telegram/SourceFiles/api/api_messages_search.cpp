@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_histories.h"
 #include "data/data_message_reaction_id.h"
 #include "data/data_peer.h"
+#include "data/data_search_index.h"
 #include "data/data_session.h"
 #include "history/history.h"
 #include "history/history_item.h"
@@ -94,6 +95,7 @@ void MessagesSearch::searchRequest() {
 			searchReceived(it->second, _requestId, nextToken);
 			return;
 		}
+		searchLocal(nextToken);
 	}
 	auto callback = [=](Fn<void()> finish) {
 		using Flag = MTPmessages_Search::Flag;
@@ -145,6 +147,22 @@ void MessagesSearch::searchRequest() {
 		std::move(callback));
 }
 
+void MessagesSearch::searchLocal(const QString &nextToken) {
+	if (!Data::SearchIndex::Enabled()
+		|| _request.from
+		|| !_request.tags.empty()) {
+		return;
+	}
+	auto messages = _history->owner().searchIndex().search(
+		_history,
+		_request.query,
+		kSearchPerPage);
+	if (!messages.empty()) {
+		const auto total = int(messages.size());
+		_messagesFounds.fire({ total, std::move(messages), nextToken, true });
+	}
+}
+
 void MessagesSearch::searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
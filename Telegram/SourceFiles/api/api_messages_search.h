@@ -24,6 +24,7 @@ struct FoundMessages {
 	int total = -1;
 	MessageIdsList messages;
 	QString nextToken;
+	bool local = false; // Found in Data::SearchIndex, not final.
 };
 
 class MessagesSearch final {
@@ -52,6 +53,7 @@ public:
 private:
 	using TLMessages = MTPmessages_Messages;
 	void searchRequest();
+	void searchLocal(const QString &nextToken);
 	void searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
@@ -37,7 +37,15 @@ MessagesSearchMerged::MessagesSearchMerged(not_null<History*> history)
 
 	_apiSearch.messagesFounds(
 	) | rpl::start_with_next([=](const FoundMessages &data) {
-		if (data.nextToken == _concatedFound.nextToken) {
+		if (data.local) {
+			// Local results are replaced by the first server page,
+			// they are shown only while there is nothing to merge with.
+			if (!_migratedSearch) {
+				_concatedFound = data;
+				_newFounds.fire({});
+			}
+		} else if (!_concatedFound.local
+			&& data.nextToken == _concatedFound.nextToken) {
 			addFound(data);
 			checkFull(data);
 			_nextFounds.fire({});
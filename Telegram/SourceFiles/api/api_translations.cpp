@@ -0,0 +1,48 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "api/api_translations.h"
+
+namespace Api {
+namespace {
+
+constexpr auto kCacheLimit = 512;
+constexpr auto kMaxCachedLength = 4096;
+
+} // namespace
+
+const TextWithEntities *Translations::lookup(
+		LanguageId to,
+		const TextWithEntities &original) {
+	const auto i = _cache.find(std::make_pair(to, original.text));
+	if (i == end(_cache) || i->second.original != original) {
+		return nullptr;
+	}
+	i->second.used = ++_usedCounter;
+	return &i->second.translated;
+}
+
+void Translations::remember(
+		LanguageId to,
+		const TextWithEntities &original,
+		const TextWithEntities &translated) {
+	if (translated.empty() || original.text.size() > kMaxCachedLength) {
+		return;
+	}
+	auto &entry = _cache[std::make_pair(to, original.text)];
+	entry.original = original;
+	entry.translated = translated;
+	entry.used = ++_usedCounter;
+	if (_cache.size() > kCacheLimit) {
+		_cache.erase(ranges::min_element(
+			_cache,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.used; }));
+	}
+}
+
+} // namespace Api
@@ -0,0 +1,38 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "spellcheck/spellcheck_types.h"
+
+namespace Api {
+
+// Remembers recent message translations by their original text,
+// so that the same text forwarded to many chats is translated once.
+class Translations final {
+public:
+	[[nodiscard]] const TextWithEntities *lookup(
+		LanguageId to,
+		const TextWithEntities &original);
+	void remember(
+		LanguageId to,
+		const TextWithEntities &original,
+		const TextWithEntities &translated);
+
+private:
+	struct Entry {
+		TextWithEntities original;
+		TextWithEntities translated;
+		uint64 used = 0;
+	};
+
+	base::flat_map<std::pair<LanguageId, QString>, Entry> _cache;
+	uint64 _usedCounter = 0;
+
+};
+
+} // namespace Api
@@ -56,6 +56,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_shared_media.h"
 #include "calls/calls_instance.h"
 #include "base/unixtime.h"
+#include "base/network_reachability.h"
 #include "window/window_session_controller.h"
 #include "window/window_controller.h"
 #include "ui/boxes/confirm_box.h"
@@ -70,6 +71,9 @@ constexpr auto kChannelGetDifferenceLimit = 100;
 // 1s wait after show channel history before sending getChannelDifference.
 constexpr auto kWaitForChannelGetDifference = crl::time(1000);
 
+// Catching up after offline, opened chats are not limited.
+constexpr auto kChannelGetDifferenceRequestsLimit = 8;
+
 // If nothing is received in 1 min we ping.
 constexpr auto kNoUpdatesTimeout = 60 * 1000;
 
@@ -235,7 +239,8 @@ Updates::Updates(not_null<Main::Session*> session)
 , _bySeqTimer([=] { getDifference(); })
 , _byMinChannelTimer([=] { getDifference(); })
 , _failDifferenceTimer([=] { getDifferenceAfterFail(); })
-, _idleFinishTimer([=] { checkIdleFinish(); }) {
+, _idleFinishTimer([=] { checkIdleFinish(); })
+, _networkReachability(base::NetworkReachability::Instance()) {
 	_ptsWaiter.setRequesting(true);
 
 	session->account().mtpUpdates(
@@ -248,6 +253,13 @@ Updates::Updates(not_null<Main::Session*> session)
 		mtpNewSessionCreated();
 	}, _lifetime);
 
+	_networkReachability->availableChanges(
+	) | rpl::filter(
+		rpl::mappers::_1
+	) | rpl::start_with_next([=] {
+		networkBecameAvailable();
+	}, _lifetime);
+
 	api().request(MTPupdates_GetState(
 	)).done([=](const MTPupdates_State &result) {
 		stateDone(result);
@@ -415,10 +427,7 @@ void Updates::channelDifferenceDone(
 			"{ good - after not final channelDifference was received }%1"
 			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
 		getChannelDifference(channel);
-	} else if (ranges::contains(
-			_activeChats,
-			channel,
-			[](const auto &pair) { return pair.second.peer; })) {
+	} else if (isActiveChat(channel)) {
 		channel->ptsWaitingForShortPoll(timeout
 			? (timeout * crl::time(1000))
 			: kWaitForChannelGetDifference);
@@ -451,6 +460,28 @@ void Updates::channelDifferenceFail(
 	failDifferenceStartTimerFor(channel);
 }
 
+bool Updates::isActiveChat(not_null<ChannelData*> channel) const {
+	return ranges::contains(
+		_activeChats,
+		channel.get(),
+		[](const auto &pair) { return pair.second.peer; });
+}
+
+void Updates::sendQueuedChannelDifferences() {
+	while (!_channelDifferenceQueue.empty()
+		&& _channelDifferenceRequests < kChannelGetDifferenceRequestsLimit) {
+		const auto i = ranges::find_if(
+			_channelDifferenceQueue,
+			[&](const auto &pair) { return isActiveChat(pair.first); });
+		const auto j = (i != end(_channelDifferenceQueue))
+			? i
+			: begin(_channelDifferenceQueue);
+		const auto [channel, from] = *j;
+		_channelDifferenceQueue.erase(j);
+		getChannelDifference(channel, from);
+	}
+}
+
 void Updates::stateDone(const MTPupdates_State &state) {
 	const auto &d = state.c_updates_state();
 	setState(d.vpts().v, d.vdate().v, d.vqts().v, d.vseq().v);
@@ -707,6 +738,14 @@ void Updates::getChannelDifference(
 		_whenGetDiffAfterFail.remove(channel);
 	}
 
+	if (_channelDifferenceRequests >= kChannelGetDifferenceRequestsLimit
+		&& !isActiveChat(channel)) {
+		_channelDifferenceQueue.emplace(channel, from);
+		return;
+	}
+	_channelDifferenceQueue.remove(channel);
+	++_channelDifferenceRequests;
+
 	channel->ptsSetRequesting(true);
 
 	auto filter = MTP_channelMessagesFilterEmpty();
@@ -723,9 +762,13 @@ void Updates::getChannelDifference(
 		MTP_int(channel->pts()),
 		MTP_int(kChannelGetDifferenceLimit)
 	)).done([=](const MTPupdates_ChannelDifference &result) {
+		--_channelDifferenceRequests;
 		channelDifferenceDone(channel, result);
+		sendQueuedChannelDifferences();
 	}).fail([=](const MTP::Error &error) {
+		--_channelDifferenceRequests;
 		channelDifferenceFail(channel, error);
+		sendQueuedChannelDifferences();
 	}).send();
 }
 
@@ -849,6 +892,17 @@ void Updates::mtpNewSessionCreated() {
 	getDifference();
 }
 
+void Updates::networkBecameAvailable() {
+	// The connections are restarted by MTP::Instance, but the session
+	// may survive that, so we won't get new_session_created to resync.
+	if (!_lastUpdateTime) {
+		return;
+	}
+	MTP_LOG(0, ("getDifference { after network became available }%1"
+		).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
+	getDifference();
+}
+
 void Updates::mtpUpdateReceived(const MTPUpdates &updates) {
 	Core::App().checkAutoLock();
 	_lastUpdateTime = crl::now();
@@ -13,6 +13,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 class ApiWrap;
 class History;
 
+namespace base {
+class NetworkReachability;
+} // namespace base
+
 namespace MTP {
 class Error;
 } // namespace MTP
@@ -117,11 +121,14 @@ private:
 	void channelDifferenceFail(
 		not_null<ChannelData*> channel,
 		const MTP::Error &error);
+	[[nodiscard]] bool isActiveChat(not_null<ChannelData*> channel) const;
+	void sendQueuedChannelDifferences();
 	void failDifferenceStartTimerFor(ChannelData *channel);
 	void feedChannelDifference(const MTPDupdates_channelDifference &data);
 
 	void mtpUpdateReceived(const MTPUpdates &updates);
 	void mtpNewSessionCreated();
+	void networkBecameAvailable();
 	void feedUpdateVector(
 		const MTPVector<MTPUpdate> &updates,
 		SkipUpdatePolicy policy = SkipUpdatePolicy::SkipNone);
@@ -171,6 +178,10 @@ private:
 
 	base::flat_map<not_null<ChannelData*>, crl::time> _whenGetDiffByPts;
 	base::flat_map<not_null<ChannelData*>, crl::time> _whenGetDiffAfterFail;
+	base::flat_map<
+		not_null<ChannelData*>,
+		ChannelDifferenceRequest> _channelDifferenceQueue;
+	int _channelDifferenceRequests = 0;
 	crl::time _getDifferenceTimeByPts = 0;
 	crl::time _getDifferenceTimeAfterFail = 0;
 
@@ -207,6 +218,8 @@ private:
 	bool _lastWasOnline = false;
 	rpl::variable<bool> _isIdle = false;
 
+	const std::shared_ptr<base::NetworkReachability> _networkReachability;
+
 	rpl::lifetime _lifetime;
 
 };
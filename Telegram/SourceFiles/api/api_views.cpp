@@ -18,8 +18,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Api {
 namespace {
 
-// Send channel views each second.
+// Send channel views each second, while new channels keep appearing
+// (like when scrolling through them) wait for them up to three seconds.
 constexpr auto kSendViewsTimeout = crl::time(1000);
+constexpr auto kSendViewsMaxDelay = 3 * crl::time(1000);
 constexpr auto kPollExtendedMediaPeriod = 30 * crl::time(1000);
 constexpr auto kMaxPollPerRequest = 100;
 
@@ -46,7 +48,7 @@ void ViewsManager::scheduleIncrement(not_null<HistoryItem*> item) {
 	auto j = _toIncrement.find(peer);
 	if (j == _toIncrement.cend()) {
 		j = _toIncrement.emplace(peer).first;
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		scheduleViewsIncrement();
 	}
 	j->second.emplace(item->id);
 }
@@ -74,7 +76,18 @@ void ViewsManager::pollExtendedMedia(not_null<HistoryItem*> item) {
 	}
 }
 
+void ViewsManager::scheduleViewsIncrement() {
+	const auto now = crl::now();
+	if (!_incrementScheduled) {
+		_incrementScheduled = now;
+	}
+	const auto latest = _incrementScheduled + kSendViewsMaxDelay;
+	_incrementTimer.callOnce(
+		std::clamp(latest - now, crl::time(0), kSendViewsTimeout));
+}
+
 void ViewsManager::viewsIncrement() {
+	_incrementScheduled = 0;
 	for (auto i = _toIncrement.begin(); i != _toIncrement.cend();) {
 		if (_incrementRequests.contains(i->first)) {
 			++i;
@@ -222,7 +235,7 @@ void ViewsManager::done(
 		}
 	}
 	if (!_toIncrement.empty() && !_incrementTimer.isActive()) {
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		scheduleViewsIncrement();
 	}
 }
 
@@ -234,7 +247,7 @@ void ViewsManager::fail(const MTP::Error &error, mtpRequestId requestId) {
 		}
 	}
 	if (!_toIncrement.empty() && !_incrementTimer.isActive()) {
-		_incrementTimer.callOnce(kSendViewsTimeout);
+		scheduleViewsIncrement();
 	}
 }
 
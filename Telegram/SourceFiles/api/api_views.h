@@ -36,6 +36,7 @@ private:
 		base::flat_set<MsgId> sent;
 	};
 
+	void scheduleViewsIncrement();
 	void viewsIncrement();
 	void sendPollRequests();
 	void sendPollRequests(
@@ -57,6 +58,7 @@ private:
 	base::flat_map<not_null<PeerData*>, mtpRequestId> _incrementRequests;
 	base::flat_map<mtpRequestId, not_null<PeerData*>> _incrementByRequest;
 	base::Timer _incrementTimer;
+	crl::time _incrementScheduled = 0;
 
 	base::flat_map<
 		not_null<PeerData*>,
@@ -31,6 +31,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_unread_things.h"
 #include "api/api_ringtones.h"
 #include "api/api_transcribes.h"
+#include "api/api_translations.h"
 #include "api/api_premium.h"
 #include "api/api_user_names.h"
 #include "api/api_websites.h"
@@ -60,8 +61,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "boxes/add_contact_box.h"
 #include "mtproto/mtproto_config.h"
 #include "history/history.h"
+#include "history/history_item.h"
 #include "history/history_item_components.h"
 #include "history/history_item_helpers.h"
+#include "history/view/history_view_element.h"
 #include "main/main_session.h"
 #include "main/main_session_settings.h"
 #include "main/main_account.h"
@@ -78,6 +81,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/text/text_utilities.h"
 #include "ui/chat/attach/attach_prepare.h"
 #include "ui/toast/toast.h"
+#include "ui/power_saving.h"
 #include "support/support_helper.h"
 #include "settings/settings_premium.h"
 #include "storage/localimageloader.h"
@@ -99,6 +103,7 @@ constexpr auto kStickersByEmojiInvalidateTimeout = crl::time(6 * 1000);
 constexpr auto kNotifySettingSaveTimeout = crl::time(1000);
 constexpr auto kDialogsFirstLoad = 20;
 constexpr auto kDialogsPerPage = 500;
+constexpr auto kDialogsPreloadDelay = 3 * crl::time(1000);
 constexpr auto kStatsSessionKillTimeout = 10 * crl::time(1000);
 
 using PhotoFileLocationId = Data::PhotoFileLocationId;
@@ -141,6 +146,29 @@ void ShowChannelsLimitBox(not_null<PeerData*> peer) {
 		action.replaceMediaOf);
 }
 
+// The loaded part of a history is contiguous, so if it has messages
+// on both sides of the date the first one after it is known locally.
+[[nodiscard]] MsgId FindLoadedMessageAfterDate(
+		not_null<History*> history,
+		TimeId date) {
+	auto hasBefore = false;
+	for (const auto &block : history->blocks) {
+		for (const auto &view : block->messages) {
+			const auto item = view->data();
+			if (!item->isRegular()) {
+				continue;
+			} else if (item->date() < date) {
+				hasBefore = true;
+			} else if (hasBefore || history->loadedAtTop()) {
+				return item->id;
+			} else {
+				return 0;
+			}
+		}
+	}
+	return 0;
+}
+
 } // namespace
 
 ApiWrap::ApiWrap(not_null<Main::Session*> session)
@@ -151,7 +179,10 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _draftsSaveTimer([=] { saveDraftsToCloud(); })
 , _featuredSetsReadTimer([=] { readFeaturedSets(); })
 , _dialogsLoadState(std::make_unique<DialogsLoadState>())
-, _fileLoader(std::make_unique<TaskQueue>(kFileLoaderQueueStopTimeout))
+, _dialogsPreloadTimer([=] { preloadArchivedDialogs(); })
+, _fileLoader(std::make_unique<TaskQueue>(
+	kFileLoaderQueueStopTimeout,
+	std::max(QThread::idealThreadCount(), 1)))
 , _topPromotionTimer([=] { refreshTopPromotion(); })
 , _updateNotifyTimer([=] { sendNotifySettingsUpdates(); })
 , _statsSessionKillTimer([=] { checkStatsSessions(); })
@@ -173,6 +204,7 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _unreadThings(std::make_unique<Api::UnreadThings>(this))
 , _ringtones(std::make_unique<Api::Ringtones>(this))
 , _transcribes(std::make_unique<Api::Transcribes>(this))
+, _translations(std::make_unique<Api::Translations>())
 , _premium(std::make_unique<Api::Premium>(this))
 , _usernames(std::make_unique<Api::Usernames>(this))
 , _websites(std::make_unique<Api::Websites>(this))
@@ -952,12 +984,28 @@ void ApiWrap::requestMoreDialogsIfNeeded() {
 			Data::Folder::kId)) {
 		if (_session->data().chatsFilters().archiveNeeded()) {
 			requestMoreDialogs(folder);
+		} else if (!folder->chatsList()->loaded()
+			&& !_dialogsPreloadTimer.isActive()) {
+			// Load the archive in the background, so that it and the
+			// filters including archived chats are ready when opened.
+			_dialogsPreloadTimer.callOnce(kDialogsPreloadDelay);
 		}
 	}
 	requestContacts();
 	_session->data().shortcutMessages().preloadShortcuts();
 }
 
+void ApiWrap::preloadArchivedDialogs() {
+	const auto folder = _session->data().folderLoaded(Data::Folder::kId);
+	if (!folder || folder->chatsList()->loaded()) {
+		return;
+	} else if (PowerSaving::ForceAll()) {
+		// Don't spend traffic and battery on what may be never opened.
+		return;
+	}
+	requestDialogs(folder);
+}
+
 void ApiWrap::updateDialogsOffset(
 		Data::Folder *folder,
 		const QVector<MTPDialog> &dialogs,
@@ -3061,6 +3109,18 @@ void ApiWrap::resolveJumpToHistoryDate(
 			std::move(callback));
 	}
 	const auto jumpToDateInPeer = [=] {
+		const auto history = topicRootId
+			? nullptr
+			: _session->data().historyLoaded(peer);
+		if (history) {
+			const auto start = date.startOfDay().toSecsSinceEpoch();
+			if (const auto itemId = FindLoadedMessageAfterDate(
+					history,
+					TimeId(start))) {
+				callback(peer, itemId);
+				return;
+			}
+		}
 		requestMessageAfterDate(peer, topicRootId, date, [=](MsgId itemId) {
 			callback(peer, itemId);
 		});
@@ -4463,6 +4523,10 @@ Api::Transcribes &ApiWrap::transcribes() {
 	return *_transcribes;
 }
 
+Api::Translations &ApiWrap::translations() {
+	return *_translations;
+}
+
 Api::Premium &ApiWrap::premium() {
 	return *_premium;
 }
@@ -80,6 +80,7 @@ class ChatParticipants;
 class UnreadThings;
 class Ringtones;
 class Transcribes;
+class Translations;
 class Premium;
 class Usernames;
 class Websites;
@@ -396,6 +397,7 @@ public:
 	[[nodiscard]] Api::UnreadThings &unreadThings();
 	[[nodiscard]] Api::Ringtones &ringtones();
 	[[nodiscard]] Api::Transcribes &transcribes();
+	[[nodiscard]] Api::Translations &translations();
 	[[nodiscard]] Api::Premium &premium();
 	[[nodiscard]] Api::Usernames &usernames();
 	[[nodiscard]] Api::Websites &websites();
@@ -439,6 +441,7 @@ private:
 		const QVector<MTPDialog> &dialogs,
 		const QVector<MTPMessage> &messages);
 	void requestMoreDialogs(Data::Folder *folder);
+	void preloadArchivedDialogs();
 	DialogsLoadState *dialogsLoadState(Data::Folder *folder);
 	void dialogsLoadFinish(Data::Folder *folder);
 
@@ -649,6 +652,7 @@ private:
 	TimeId _dialogsLoadTill = 0;
 	rpl::variable<bool> _dialogsLoadMayBlockByDate = false;
 	rpl::variable<bool> _dialogsLoadBlockedByDate = false;
+	base::Timer _dialogsPreloadTimer;
 
 	base::flat_map<
 		not_null<Data::Folder*>,
@@ -716,6 +720,7 @@ private:
 	const std::unique_ptr<Api::UnreadThings> _unreadThings;
 	const std::unique_ptr<Api::Ringtones> _ringtones;
 	const std::unique_ptr<Api::Transcribes> _transcribes;
+	const std::unique_ptr<Api::Translations> _translations;
 	const std::unique_ptr<Api::Premium> _premium;
 	const std::unique_ptr<Api::Usernames> _usernames;
 	const std::unique_ptr<Api::Websites> _websites;
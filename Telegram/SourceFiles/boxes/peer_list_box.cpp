@@ -1103,6 +1103,7 @@ void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
 	}
 
 	removeFromSearchIndex(row);
+	_searchIndexChanged = true;
 	row->setNameFirstLetters(row->generateNameFirstLetters());
 	for (auto ch : row->nameFirstLetters()) {
 		_searchIndex[ch].push_back(row);
@@ -1243,6 +1244,7 @@ void PeerListContent::clearAllContent() {
 	_rowsByPeer.clear();
 	_filterResults.clear();
 	_searchIndex.clear();
+	_localSearchWords = QStringList();
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -1997,10 +1999,32 @@ void PeerListContent::searchQueryChanged(QString query) {
 	const auto searchWordsList = TextUtilities::PrepareSearchWords(query);
 	const auto normalizedQuery = searchWordsList.join(' ');
 	if (_normalizedSearchQuery != normalizedQuery) {
+		// When the new words only extend the previous ones the results
+		// can only narrow down, so filter the previous local results.
+		const auto refines = !_searchIndexChanged
+			&& !_localSearchWords.isEmpty()
+			&& (searchWordsList.size() >= _localSearchWords.size())
+			&& ranges::all_of(
+				ranges::views::iota(0, int(_localSearchWords.size())),
+				[&](int i) {
+					return searchWordsList[i].startsWith(
+						_localSearchWords[i]);
+				});
+		auto previous = std::vector<not_null<PeerListRow*>>();
+		if (refines) {
+			previous = _filterResults | ranges::views::filter([](
+					not_null<PeerListRow*> row) {
+				return !row->isSearchResult();
+			}) | ranges::to_vector;
+		}
 		setSearchQuery(query, normalizedQuery);
+		_localSearchWords = QStringList();
+		_searchIndexChanged = false;
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty());
 
+			_localSearchWords = searchWordsList;
+
 			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
 			for (const auto &searchWord : searchWordsList) {
 				auto searchWordStart = searchWord[0].toLower();
@@ -2013,6 +2037,11 @@ void PeerListContent::searchQueryChanged(QString query) {
 					minimalList = &it->second;
 				}
 			}
+			if (minimalList
+				&& refines
+				&& previous.size() < minimalList->size()) {
+				minimalList = &previous;
+			}
 			if (minimalList) {
 				auto searchWordInNames = [](
 						not_null<PeerListRow*> row,
@@ -668,6 +668,7 @@ public:
 		for (auto &searchEntity : _searchIndex) {
 			callback(searchEntity.second.begin(), searchEntity.second.end());
 		}
+		_searchIndexChanged = true;
 		refreshIndices();
 		if (!_hiddenRows.empty()) {
 			callback(_filterResults.begin(), _filterResults.end());
@@ -834,6 +835,8 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	QStringList _localSearchWords;
+	bool _searchIndexChanged = false;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
@@ -1495,6 +1495,9 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 		MessageIdsList msgIds) {
 	struct State final {
 		base::flat_set<mtpRequestId> requests;
+		base::flat_set<not_null<Data::Thread*>> forwarded;
+		base::flat_set<not_null<Data::Thread*>> commented;
+		bool failed = false;
 	};
 	const auto state = std::make_shared<State>();
 	return [=](
@@ -1505,6 +1508,13 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 		if (!state->requests.empty()) {
 			return; // Share clicked already.
 		}
+		// After some of the requests failed the box stays open,
+		// share again only to the chats that didn't get the messages.
+		result.erase(ranges::remove_if(result, [&](
+				not_null<Data::Thread*> thread) {
+			return state->forwarded.contains(thread);
+		}), end(result));
+		state->failed = false;
 		const auto items = history->owner().idsToItems(msgIds);
 		const auto existingIds = history->owner().itemsToIds(items);
 		if (existingIds.empty() || result.empty()) {
@@ -1563,7 +1573,10 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 			msgIds);
 		const auto requestType = Data::Histories::RequestType::Send;
 		for (const auto thread : result) {
-			if (!comment.text.isEmpty()) {
+			// The comment goes right before the first forward attempt,
+			// a retry after a failed forward doesn't send it again.
+			if (!comment.text.isEmpty()
+				&& state->commented.emplace(thread).second) {
 				auto message = Api::MessageToSend(
 					Api::SendAction(thread, options));
 				message.textWithTags = comment;
@@ -1603,7 +1616,8 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 				)).done([=](const MTPUpdates &updates, mtpRequestId reqId) {
 					threadHistory->session().api().applyUpdates(updates);
 					state->requests.remove(reqId);
-					if (state->requests.empty()) {
+					state->forwarded.emplace(thread);
+					if (state->requests.empty() && !state->failed) {
 						if (show->valid()) {
 							auto phrase = rpl::variable<TextWithEntities>(
 								ChatHelpers::ForwardedMessagePhrase(
@@ -1613,7 +1627,7 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 						}
 					}
 					finish();
-				}).fail([=](const MTP::Error &error) {
+				}).fail([=](const MTP::Error &error, mtpRequestId reqId) {
 					if (error.type() == u"VOICE_MESSAGES_FORBIDDEN"_q) {
 						show->showToast(
 							tr::lng_restricted_send_voice_messages(
@@ -1621,6 +1635,8 @@ ShareBox::SubmitCallback ShareBox::DefaultForwardCallback(
 								lt_user,
 								peer->name()));
 					}
+					state->requests.remove(reqId);
+					state->failed = true;
 					finish();
 				}).afterRequest(threadHistory->sendRequestId).send();
 				return threadHistory->sendRequestId;
@@ -652,6 +652,19 @@ void Members::Controller::checkRowPosition(not_null<Row*> row) {
 		return;
 	}
 
+	if (!_peer->canManageGroupCall()) {
+		// Only a speaking 'row' can get here, two linear passes are enough:
+		// all speaking to the top and then 'row' above them.
+		Assert(row->speaking());
+		delegate()->peerListPartitionRows([](const PeerListRow &other) {
+			return static_cast<const Row&>(other).speaking();
+		});
+		delegate()->peerListPartitionRows([&](const PeerListRow &other) {
+			return (&other == row.get());
+		});
+		return;
+	}
+
 	// Someone started speaking and has a non-speaking row above him.
 	// Or someone raised hand and has force muted above him.
 	// Or someone was forced muted and had can_unmute_self below him. Sort.
@@ -670,23 +683,11 @@ void Members::Controller::checkRowPosition(not_null<Row*> row) {
 			// All not force-muted lie between raised hands and speaking.
 			: (kTop - 2);
 	};
-	const auto projForOther = [&](const PeerListRow &other) {
-		const auto &real = static_cast<const Row&>(other);
-		return real.speaking()
-			// Speaking 'row' to the top, all other speaking below it.
-			? (&real == row.get() ? kTop : (kTop - 1))
-			: 0ULL;
-	};
-
-	using Comparator = Fn<bool(const PeerListRow&, const PeerListRow&)>;
-	const auto makeComparator = [&](const auto &proj) -> Comparator {
-		return [&](const PeerListRow &a, const PeerListRow &b) {
-			return proj(a) > proj(b);
-		};
-	};
-	delegate()->peerListSortRows(_peer->canManageGroupCall()
-		? makeComparator(projForAdmin)
-		: makeComparator(projForOther));
+	delegate()->peerListSortRows([&](
+			const PeerListRow &a,
+			const PeerListRow &b) {
+		return projForAdmin(a) > projForAdmin(b);
+	});
 }
 
 void Members::Controller::updateRow(
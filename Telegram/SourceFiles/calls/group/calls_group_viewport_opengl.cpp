@@ -432,9 +432,11 @@ void Viewport::RendererGL::paint(
 	const auto defaultFramebufferObject = widget->defaultFramebufferObject();
 
 	validateDatas();
+	const auto bounding = QRect(QPoint(), _viewport);
 	auto index = 0;
 	for (const auto &tile : _owner->_tiles) {
-		if (!tile->visible()) {
+		if (!tile->visible() || !tile->geometry().intersects(bounding)) {
+			// Don't upload frames of tiles scrolled out of the viewport.
 			index++;
 			continue;
 		}
@@ -49,6 +49,13 @@ void Viewport::RendererSW::paintFallback(
 	for (const auto &tile : _owner->_tiles) {
 		if (!tile->visible()) {
 			continue;
+		} else if (!tile->geometry().intersects(bounding)) {
+			// Scrolled out, keep the cached frames without converting.
+			const auto i = _tileData.find(tile.get());
+			if (i != end(_tileData)) {
+				i->second.stale = false;
+			}
+			continue;
 		}
 		paintTile(p, tile.get(), bounding, bg);
 	}
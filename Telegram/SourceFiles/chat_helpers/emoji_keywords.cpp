@@ -175,26 +175,16 @@ void WriteLocalCache(const QString &id, const LangPackData &data) {
 
 void AppendFoundEmoji(
 		std::vector<Result> &result,
+		base::flat_set<EmojiPtr> &added,
 		const QString &label,
 		const std::vector<LangPackEmoji> &list) {
-	// It is important that the 'result' won't relocate while inserting.
-	result.reserve(result.size() + list.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		list
-	) | ranges::views::filter([&](const LangPackEmoji &entry) {
-		const auto i = ranges::find(
-			alreadyBegin,
-			alreadyEnd,
-			entry.emoji,
-			&Result::emoji);
-		return (i == alreadyEnd);
-	}) | ranges::views::transform([&](const LangPackEmoji &entry) {
-		return Result{ entry.emoji, label, entry.text };
-	});
-	result.insert(end(result), add.begin(), add.end());
+	// Short prefixes match thousands of keywords, so check duplicates
+	// in the 'added' set instead of searching the whole 'result'.
+	for (const auto &entry : list) {
+		if (added.emplace(entry.emoji).second) {
+			result.push_back({ entry.emoji, label, entry.text });
+		}
+	}
 }
 
 void AppendLegacySuggestions(
@@ -489,8 +479,9 @@ std::vector<Result> EmojiKeywords::LangPack::query(
 	});
 
 	auto result = std::vector<Result>();
+	auto added = base::flat_set<EmojiPtr>();
 	for (const auto &[key, list] : chosen) {
-		AppendFoundEmoji(result, key, list);
+		AppendFoundEmoji(result, added, key, list);
 	}
 	return result;
 }
@@ -613,27 +604,18 @@ std::vector<Result> EmojiKeywords::query(
 		return {};
 	}
 	auto result = std::vector<Result>();
+	auto added = base::flat_set<EmojiPtr>();
 	for (const auto &[language, item] : _data) {
 		const auto list = item->query(normalized, exact);
 
-		// It is important that the 'result' won't relocate while inserting.
+		// In each item->query() result the list has no duplicates.
+		// So we need to check only for duplicates between queries.
 		result.reserve(result.size() + list.size());
-		const auto alreadyBegin = begin(result);
-		const auto alreadyEnd = alreadyBegin + result.size();
-
-		auto &&add = ranges::views::all(
-			list
-		) | ranges::views::filter([&](Result entry) {
-			// In each item->query() result the list has no duplicates.
-			// So we need to check only for duplicates between queries.
-			const auto i = ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji);
-			return (i == alreadyEnd);
-		});
-		result.insert(end(result), add.begin(), add.end());
+		for (const auto &entry : list) {
+			if (added.emplace(entry.emoji).second) {
+				result.push_back(entry);
+			}
+		}
 	}
 	if (!exact) {
 		AppendLegacySuggestions(result, query);
@@ -680,7 +680,7 @@ void EmojiListWidget::appendPremiumSearchResults() {
 			const auto id = one.document->id;
 			if (checkCustom(one.emoji, id)) {
 				_searchResults.push_back({
-					.custom = one.custom,
+					.custom = resolveCustomOne(set, one),
 					.id = { RecentEmojiDocument{ .id = id, .test = test } },
 				});
 			}
@@ -827,7 +827,9 @@ void EmojiListWidget::unloadCustomIn(const SectionInfo &info) {
 	}
 	custom.painted = false;
 	for (const auto &single : custom.list) {
-		single.custom->unload();
+		if (const auto instance = single.custom) {
+			instance->unload();
+		}
 	}
 }
 
@@ -1500,7 +1502,7 @@ void EmojiListWidget::drawCustom(
 	_emojiPaintContext->position = position
 		+ _innerPosition
 		+ _customPosition;
-	entry.custom->paint(p, *_emojiPaintContext);
+	resolveCustomOne(custom, entry)->paint(p, *_emojiPaintContext);
 }
 
 bool EmojiListWidget::checkPickerHide() {
@@ -2223,7 +2225,6 @@ void EmojiListWidget::refreshCustom() {
 				continue;
 			} else if (const auto sticker = document->sticker()) {
 				set.push_back({
-					.custom = resolveCustomEmoji(document, lookupId),
 					.document = document,
 					.emoji = Ui::Emoji::Find(sticker->alt),
 				});
@@ -2276,6 +2277,17 @@ Fn<void()> EmojiListWidget::repaintCallback(
 	};
 }
 
+not_null<Ui::Text::CustomEmoji*> EmojiListWidget::resolveCustomOne(
+		const CustomSet &set,
+		const CustomOne &one) {
+	// Instances are created once the emoji is painted or found,
+	// so opening the panel doesn't create them for all the sets.
+	if (!one.custom) {
+		one.custom = resolveCustomEmoji(one.document, set.set->id);
+	}
+	return one.custom;
+}
+
 not_null<Ui::Text::CustomEmoji*> EmojiListWidget::resolveCustomEmoji(
 		not_null<DocumentData*> document,
 		uint64 setId) {
@@ -2292,11 +2304,17 @@ not_null<Ui::Text::CustomEmoji*> EmojiListWidget::resolveCustomEmoji(
 		repaintCallback(documentId, setId),
 		Data::CustomEmojiManager::SizeTag::Large);
 	if (recentOnly) {
+		const auto was = i->second.emoji.get();
 		for (auto &recent : _recent) {
-			if (recent.custom && recent.custom == i->second.emoji.get()) {
+			if (recent.custom == was) {
 				recent.custom = instance.get();
 			}
 		}
+		for (auto &found : _searchResults) {
+			if (found.custom == was) {
+				found.custom = instance.get();
+			}
+		}
 		i->second.emoji = std::move(instance);
 		i->second.recentOnly = false;
 		return i->second.emoji.get();
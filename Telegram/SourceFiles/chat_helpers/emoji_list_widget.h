@@ -178,7 +178,7 @@ private:
 		bool collapsed = false;
 	};
 	struct CustomOne {
-		not_null<Ui::Text::CustomEmoji*> custom;
+		mutable Ui::Text::CustomEmoji *custom = nullptr; // Created lazily.
 		not_null<DocumentData*> document;
 		EmojiPtr emoji = nullptr;
 	};
@@ -363,6 +363,9 @@ private:
 
 	void fillRecent();
 	void fillRecentFrom(const std::vector<DocumentId> &list);
+	[[nodiscard]] not_null<Ui::Text::CustomEmoji*> resolveCustomOne(
+		const CustomSet &set,
+		const CustomOne &one);
 	[[nodiscard]] not_null<Ui::Text::CustomEmoji*> resolveCustomEmoji(
 		not_null<DocumentData*> document,
 		uint64 setId);
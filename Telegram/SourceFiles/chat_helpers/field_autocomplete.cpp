@@ -60,6 +60,24 @@ namespace {
 	return usernames.empty() ? user->username() : usernames.front();
 }
 
+// Same as (command + '@' + username).startsWith(filter), without
+// building the string for each command on each keystroke.
+[[nodiscard]] bool CommandPassesFilter(
+		const QString &command,
+		const QString &username,
+		bool withUsername,
+		const QString &filter) {
+	if (!withUsername || filter.size() <= command.size()) {
+		return command.startsWith(filter, Qt::CaseInsensitive);
+	}
+	const auto view = QStringView(filter);
+	return view.startsWith(command, Qt::CaseInsensitive)
+		&& (view[command.size()] == '@')
+		&& QStringView(username).startsWith(
+			view.mid(command.size() + 1),
+			Qt::CaseInsensitive);
+}
+
 } // namespace
 
 class FieldAutocomplete::Inner final : public Ui::RpWidget {
@@ -373,18 +391,6 @@ bool FieldAutocomplete::clearFilteredBotCommands() {
 	return true;
 }
 
-namespace {
-template <typename T, typename U>
-inline int indexOfInFirstN(const T &v, const U &elem, int last) {
-	for (auto b = v.cbegin(), i = b, e = b + std::max(int(v.size()), last); i != e; ++i) {
-		if (i->user == elem) {
-			return (i - b);
-		}
-	}
-	return -1;
-}
-}
-
 FieldAutocomplete::StickerRows FieldAutocomplete::getStickerSuggestions() {
 	const auto data = &_session->data().stickers();
 	const auto list = data->getListByEmoji({ _emoji }, _stickersSeed);
@@ -456,6 +462,13 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 		};
 
 		bool listAllSuggestions = _filter.isEmpty();
+		auto added = base::flat_set<not_null<UserData*>>();
+		added.reserve(maxListSize);
+		const auto push = [&](not_null<UserData*> user) {
+			if (added.emplace(user).second) {
+				mrows.push_back({ user });
+			}
+		};
 		if (_addInlineBots) {
 			for (const auto user : cRecentInlineBots()) {
 				if (user->isInaccessible()
@@ -463,7 +476,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 						&& filterNotPassedByUsername(user))) {
 					continue;
 				}
-				mrows.push_back({ user });
+				push(user);
 				++recentInlineBots;
 			}
 		}
@@ -479,15 +492,15 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				for (const auto &user : _chat->participants) {
 					if (user->isInaccessible()) continue;
 					if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-					if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
+					if (added.contains(user)) continue;
 					sorted.emplace(byOnline(user), user);
 				}
 			}
 			for (const auto user : _chat->lastAuthors) {
 				if (user->isInaccessible()) continue;
 				if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-				if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-				mrows.push_back({ user });
+				if (added.contains(user)) continue;
+				push(user);
 				sorted.remove(byOnline(user), user);
 			}
 			for (auto i = sorted.cend(), b = sorted.cbegin(); i != b;) {
@@ -504,8 +517,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 						if (const auto user = _channel->owner().userLoaded(userId)) {
 							if (user->isInaccessible()) continue;
 							if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-							if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-							mrows.push_back({ user });
+							push(user);
 						}
 					}
 				}
@@ -517,8 +529,7 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 				for (const auto user : _channel->mgInfo->lastParticipants) {
 					if (user->isInaccessible()) continue;
 					if (!listAllSuggestions && filterNotPassedByName(user)) continue;
-					if (indexOfInFirstN(mrows, user, recentInlineBots) >= 0) continue;
-					mrows.push_back({ user });
+					push(user);
 				}
 			}
 		}
@@ -599,6 +610,9 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			};
 			brows.reserve(cnt);
 			int32 botStatus = _chat ? _chat->botStatus : ((_channel && _channel->isMegagroup()) ? _channel->mgInfo->botStatus : -1);
+			const auto withUsername = hasUsername
+				|| (botStatus == 0)
+				|| (botStatus == 2);
 			if (_chat) {
 				for (const auto &user : _chat->lastAuthors) {
 					if (!user->isBot()) {
@@ -608,14 +622,15 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 					if (i == end(bots)) {
 						continue;
 					}
+					const auto username = PrimaryUsername(user);
 					for (const auto &command : *i->second) {
-						if (!listAllSuggestions) {
-							auto toFilter = (hasUsername || botStatus == 0 || botStatus == 2)
-								? command.command + '@' + PrimaryUsername(user)
-								: command.command;
-							if (!toFilter.startsWith(_filter, Qt::CaseInsensitive)/* || toFilter.size() == _filter.size()*/) {
-								continue;
-							}
+						if (!listAllSuggestions
+							&& !CommandPassesFilter(
+								command.command,
+								username,
+								withUsername,
+								_filter)) {
+							continue;
 						}
 						brows.push_back(make(user, command));
 					}
@@ -625,14 +640,15 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			if (!bots.empty()) {
 				for (auto i = bots.cbegin(), e = bots.cend(); i != e; ++i) {
 					const auto user = i->first;
+					const auto username = PrimaryUsername(user);
 					for (const auto &command : *i->second) {
-						if (!listAllSuggestions) {
-							const auto toFilter = (hasUsername
-									|| botStatus == 0
-									|| botStatus == 2)
-								? command.command + '@' + PrimaryUsername(user)
-								: command.command;
-							if (!toFilter.startsWith(_filter, Qt::CaseInsensitive)/* || toFilter.size() == _filter.size()*/) continue;
+						if (!listAllSuggestions
+							&& !CommandPassesFilter(
+								command.command,
+								username,
+								withUsername,
+								_filter)) {
+							continue;
 						}
 						brows.push_back(make(user, command));
 					}
@@ -640,11 +656,14 @@ void FieldAutocomplete::updateFiltered(bool resetScroll) {
 			}
 		}
 		const auto shortcuts = (_user && !_user->isBot())
-			? _user->owner().shortcutMessages().shortcuts().list
-			: base::flat_map<BusinessShortcutId, Data::Shortcut>();
-		if (!hasUsername && brows.empty() && !shortcuts.empty()) {
+			? &_user->owner().shortcutMessages().shortcuts().list
+			: nullptr;
+		if (!hasUsername
+			&& brows.empty()
+			&& shortcuts
+			&& !shortcuts->empty()) {
 			const auto self = _user->session().user();
-			for (const auto &[id, shortcut] : shortcuts) {
+			for (const auto &[id, shortcut] : *shortcuts) {
 				if (shortcut.count < 1) {
 					continue;
 				} else if (!listAllSuggestions) {
@@ -252,11 +252,33 @@ void GifsListWidget::visibleTopBottomUpdated(
 	Inner::visibleTopBottomUpdated(visibleTop, visibleBottom);
 	if (top != getVisibleTop()) {
 		_lastScrolledAt = crl::now();
+		unloadHeavyPartsOutsideVisible();
 		update();
 	}
 	checkLoadMore();
 }
 
+void GifsListWidget::unloadHeavyPartsOutsideVisible() {
+	// Keep decoders only for rows around the visible area.
+	const auto visibleHeight = getVisibleBottom() - getVisibleTop();
+	const auto from = getVisibleTop() - visibleHeight;
+	const auto till = getVisibleBottom() + visibleHeight;
+	auto top = 0;
+	for (auto row = 0, rows = _mosaic.rowsCount(); row != rows; ++row) {
+		const auto height = _mosaic.rowHeightAt(row);
+		if (top + height <= from || top >= till) {
+			for (auto column = 0;; ++column) {
+				const auto item = _mosaic.maybeItemAt(row, column);
+				if (!item) {
+					break;
+				}
+				item->unloadHeavyPart();
+			}
+		}
+		top += height;
+	}
+}
+
 void GifsListWidget::checkLoadMore() {
 	auto visibleHeight = (getVisibleBottom() - getVisibleTop());
 	if (getVisibleBottom() + visibleHeight > height()) {
@@ -141,6 +141,7 @@ private:
 
 	void setupSearch();
 	void clearHeavyData();
+	void unloadHeavyPartsOutsideVisible();
 	void cancelGifsSearch();
 	void switchToSavedGifs();
 	void refreshSavedGifs();
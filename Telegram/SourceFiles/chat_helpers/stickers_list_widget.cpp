@@ -688,6 +688,7 @@ void StickersListWidget::fillLocalSearchRows(const QString &query) {
 		return true;
 	};
 
+	ensureSearchIndex();
 	const auto &sets = session().data().stickers().sets();
 	for (const auto &[setId, titleWords] : _searchIndex) {
 		if (allSearchWordsInTitle(titleWords)) {
@@ -2020,7 +2021,17 @@ void StickersListWidget::refreshSearchSets() {
 }
 
 void StickersListWidget::refreshSearchIndex() {
+	// The words are prepared only when a search needs them, sets get
+	// refreshed much more often than searched for.
 	_searchIndex.clear();
+	_searchIndexValid = false;
+}
+
+void StickersListWidget::ensureSearchIndex() {
+	if (_searchIndexValid) {
+		return;
+	}
+	_searchIndexValid = true;
 	for (const auto &set : _mySets) {
 		if (set.flags & SetFlag::Special) {
 			continue;
@@ -2132,19 +2143,24 @@ auto StickersListWidget::collectRecentStickers() -> std::vector<Sticker> {
 	result.reserve(cloudCount + recent.size() + customCount);
 	_custom.reserve(cloudCount + recent.size() + customCount);
 
+	// With all recent stickers shown the list may get long.
+	auto indices = base::flat_map<not_null<DocumentData*>, int>();
+	indices.reserve(cloudCount + recent.size() + customCount);
+
 	auto add = [&](not_null<DocumentData*> document, bool custom) {
 		if (result.size() >= kRecentDisplayLimit
 			&& !Core::App().settings().fork().allRecentStickers()) {
 			return;
 		}
-		const auto i = ranges::find(result, document, &Sticker::document);
-		if (i != end(result)) {
-			const auto index = (i - begin(result));
+		const auto i = indices.find(document);
+		if (i != end(indices)) {
+			const auto index = i->second;
 			if (index >= cloudCount && custom) {
 				// Mark stickers from local recent as custom.
 				_custom[index] = true;
 			}
 		} else if (!_favedStickersMap.contains(document)) {
+			indices.emplace(document, int(result.size()));
 			result.push_back(Sticker{
 				document
 			});
@@ -236,6 +236,7 @@ private:
 	void refreshFeaturedSets();
 	void refreshSearchSets();
 	void refreshSearchIndex();
+	void ensureSearchIndex();
 
 	bool setHasTitle(const Set &set) const;
 	bool stickerHasDeleteButton(const Set &set, int index) const;
@@ -421,6 +422,7 @@ private:
 	std::vector<not_null<DocumentData*>> _filteredStickers;
 	std::map<QString, std::vector<uint64>> _searchCache;
 	std::vector<std::pair<uint64, QStringList>> _searchIndex;
+	bool _searchIndexValid = false;
 	base::Timer _searchRequestTimer;
 	QString _searchQuery, _searchNextQuery;
 	mtpRequestId _searchRequestId = 0;
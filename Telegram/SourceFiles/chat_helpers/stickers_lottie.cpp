@@ -25,6 +25,62 @@ namespace ChatHelpers {
 namespace {
 
 constexpr auto kDontCacheLottieAfterArea = 512 * 512;
+constexpr auto kSharedCacheKeysLimit = 4096;
+
+struct SharedCacheKey {
+	uint64 high = 0;
+	uint64 low = 0;
+	uint8 replacementsTag = 0;
+	Lottie::Quality quality = Lottie::Quality();
+
+	friend inline auto operator<=>(
+		const SharedCacheKey &a,
+		const SharedCacheKey &b) = default;
+};
+
+struct SharedCacheEntry {
+	QSize box;
+	uint8 keyShift = 0;
+};
+
+// Frames cached for the same sticker at the same box by one surface
+// (chat, panel, reactions) are reused by the others instead of
+// rendering the same frames once more under their own size tag.
+base::flat_map<
+	SharedCacheKey,
+	std::vector<SharedCacheEntry>> SharedCacheKeys;
+
+[[nodiscard]] uint8 SharedKeyShift(
+		Storage::Cache::Key baseKey,
+		uint8 keyShift,
+		Lottie::Quality quality,
+		QSize box) {
+	if (SharedCacheKeys.size() >= kSharedCacheKeysLimit) {
+		SharedCacheKeys.clear();
+	}
+	auto &entries = SharedCacheKeys[SharedCacheKey{
+		.high = baseKey.high,
+		.low = baseKey.low,
+		.replacementsTag = uint8(keyShift & 0xF0),
+		.quality = quality,
+	}];
+	for (const auto &entry : entries) {
+		if (entry.box == box) {
+			return entry.keyShift;
+		}
+	}
+	const auto i = ranges::find(
+		entries,
+		keyShift,
+		&SharedCacheEntry::keyShift);
+	if (i != end(entries)) {
+		// This key will be overwritten with frames of the new box.
+		i->box = box;
+	} else {
+		entries.push_back({ .box = box, .keyShift = keyShift });
+	}
+	return keyShift;
+}
 
 } // namespace
 
@@ -67,7 +123,8 @@ auto LottieFromDocument(
 		Method &&method,
 		not_null<Data::DocumentMedia*> media,
 		uint8 keyShift,
-		QSize box) {
+		QSize box,
+		std::optional<Lottie::Quality> shareWithQuality = std::nullopt) {
 	const auto document = media->owner();
 	const auto data = media->bytes();
 	const auto filepath = document->filepath();
@@ -81,7 +138,9 @@ auto LottieFromDocument(
 		return LottieCachedFromContent(
 			std::forward<Method>(method),
 			baseKey,
-			keyShift,
+			(shareWithQuality
+				? SharedKeyShift(baseKey, keyShift, *shareWithQuality, box)
+				: keyShift),
 			&document->session(),
 			Lottie::ReadContent(data, filepath),
 			box);
@@ -123,7 +182,12 @@ std::unique_ptr<Lottie::SinglePlayer> LottiePlayerFromDocument(
 	const auto keyShift = LottieCacheKeyShift(
 		replacements ? replacements->tag : uint8(0),
 		sizeTag);
-	return LottieFromDocument(method, media, uint8(keyShift), box);
+	return LottieFromDocument(
+		method,
+		media,
+		uint8(keyShift),
+		box,
+		quality);
 }
 
 not_null<Lottie::Animation*> LottieAnimationFromDocument(
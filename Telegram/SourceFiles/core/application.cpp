@@ -27,6 +27,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/sandbox.h"
 #include "core/local_url_handlers.h"
 #include "core/launcher.h"
+#include "core/power_saving_governor.h"
 #include "core/ui_integration.h"
 #include "chat_helpers/emoji_keywords.h"
 #include "chat_helpers/stickers_emoji_image_loader.h"
@@ -57,6 +58,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/file_utilities.h"
 #include "core/click_handler_types.h" // ClickHandlerContext.
 #include "core/crash_reports.h"
+#include "core/tracing.h"
 #include "main/main_account.h"
 #include "main/main_domain.h"
 #include "main/main_session.h"
@@ -117,6 +119,27 @@ constexpr auto kFileOpenTimeoutMs = crl::time(1000);
 
 LaunchState GlobalLaunchState/* = LaunchState::Running*/;
 
+// Collects durations of the Application::run() phases for the log.
+class StartupPhases final {
+public:
+	void mark(const char *name) {
+		const auto now = crl::now();
+		_phases.push_back(u"%1 %2ms"_q.arg(name).arg(now - _last));
+		_last = now;
+	}
+	void log() const {
+		LOG(("App Info: Startup phases: %1, total %2ms."
+			).arg(_phases.join(u", "_q)
+			).arg(_last - _started));
+	}
+
+private:
+	crl::time _started = crl::now();
+	crl::time _last = _started;
+	QStringList _phases;
+
+};
+
 void SetCrashAnnotationsGL() {
 #ifdef Q_OS_WIN
 	CrashReports::SetAnnotation("OpenGL ANGLE", [] {
@@ -239,6 +262,7 @@ Application::~Application() {
 	Window::Theme::Uninitialize();
 
 	_mediaControlsManager = nullptr;
+	_powerSavingGovernor = nullptr;
 
 	Media::Player::finish(_audio.get());
 	style::StopManager();
@@ -247,6 +271,10 @@ Application::~Application() {
 }
 
 void Application::run() {
+	TRACE_SCOPE("Application::run");
+
+	auto phases = StartupPhases();
+
 	// Depends on OpenSSL on macOS, so on ThirdParty::start().
 	// Depends on notifications settings.
 	_notifications = std::make_unique<Window::Notifications::System>();
@@ -260,6 +288,8 @@ void Application::run() {
 
 	refreshGlobalProxy(); // Depends on app settings being read.
 
+	phases.mark("settings");
+
 	if (const auto old = Local::oldSettingsVersion(); old < AppVersion) {
 		InvokeQueued(this, [] { RegisterUrlScheme(); });
 		Platform::NewVersionLaunched(old);
@@ -298,6 +328,12 @@ void Application::run() {
 	) | rpl::start_with_next([=](bool saving, bool ignore) {
 		PowerSaving::SetForceAll(saving && !ignore);
 	}, _lifetime);
+	if (PowerSavingGovernor::Enabled()) {
+		_powerSavingGovernor = std::make_unique<PowerSavingGovernor>(
+			appDeactivatedValue() | rpl::map(!rpl::mappers::_1));
+	}
+
+	phases.mark("ui");
 
 	style::ShortAnimationPlaying(
 	) | rpl::start_with_next([=](bool playing) {
@@ -312,9 +348,6 @@ void Application::run() {
 
 	DEBUG_LOG(("Application Info: starting app..."));
 
-	// Create mime database, so it won't be slow later.
-	QMimeDatabase().mimeTypeForName(u"text/plain"_q);
-
 	_primaryWindows.emplace(nullptr, std::make_unique<Window::Controller>());
 	setLastActiveWindow(_primaryWindows.front().second.get());
 	_windowInSettings = _lastActivePrimaryWindow = _lastActiveWindow;
@@ -362,9 +395,13 @@ void Application::run() {
 
 	DEBUG_LOG(("Application Info: window created..."));
 
+	phases.mark("window");
+
 	startDomain();
 	style::SetSquareUserpics(settings().fork().squareUserpics());
 
+	phases.mark("domain");
+
 	startTray();
 
 	_lastActivePrimaryWindow->firstShow();
@@ -374,6 +411,15 @@ void Application::run() {
 	DEBUG_LOG(("Application Info: showing."));
 	_lastActivePrimaryWindow->finishFirstShow();
 
+	phases.mark("show");
+	phases.log();
+
+	// Create mime database, so it won't be slow later.
+	// Not needed for the first frame, so do it after the first show.
+	InvokeQueued(this, [] {
+		QMimeDatabase().mimeTypeForName(u"text/plain"_q);
+	});
+
 	if (!_lastActivePrimaryWindow->locked() && cStartToSettings()) {
 		_lastActivePrimaryWindow->showSettings();
 	}
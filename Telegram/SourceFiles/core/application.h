@@ -115,6 +115,7 @@ namespace Core {
 struct LocalUrlHandler;
 class Settings;
 class Tray;
+class PowerSavingGovernor;
 
 enum class LaunchState {
 	Running,
@@ -417,6 +418,7 @@ private:
 
 	using MediaControlsManager = Media::SystemMediaControlsManager;
 	std::unique_ptr<MediaControlsManager> _mediaControlsManager;
+	std::unique_ptr<PowerSavingGovernor> _powerSavingGovernor;
 	const std::unique_ptr<Data::DownloadManager> _downloadManager;
 	const std::unique_ptr<Main::Domain> _domain;
 	const std::unique_ptr<Export::Manager> _exportManager;
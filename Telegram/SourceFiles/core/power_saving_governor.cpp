@@ -0,0 +1,130 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/power_saving_governor.h"
+
+#include "base/options.h"
+#include "ui/power_saving.h"
+
+namespace Core {
+namespace {
+
+constexpr auto kProbeInterval = crl::time(100);
+constexpr auto kProbesInWindow = 20;
+constexpr auto kBusyLag = crl::time(40);
+constexpr auto kIdleLag = crl::time(8);
+constexpr auto kIdleWindowsToRelease = 5;
+
+// Most expensive first, the order in which the flags get engaged.
+constexpr auto kGovernedFlags = std::array{
+	PowerSaving::kChatBackground,
+	PowerSaving::kChatSpoiler,
+	PowerSaving::kEmojiChat,
+	PowerSaving::kStickersChat,
+	PowerSaving::kEmojiReactions,
+	PowerSaving::kEmojiStatus,
+	PowerSaving::kAnimations,
+};
+
+base::options::toggle OptionAdaptivePowerSaving({
+	.id = kOptionAdaptivePowerSaving,
+	.name = "Adaptive power saving",
+	.description = "Temporarily disable expensive animations"
+		" while the interface can't keep up and restore them later.",
+	.restartRequired = true,
+});
+
+} // namespace
+
+const char kOptionAdaptivePowerSaving[] = "adaptive-power-saving";
+
+PowerSavingGovernor::PowerSavingGovernor(rpl::producer<bool> appActive)
+: _probeTimer([=] { probe(); }) {
+	std::move(
+		appActive
+	) | rpl::start_with_next([=](bool active) {
+		setActive(active);
+	}, _lifetime);
+}
+
+PowerSavingGovernor::~PowerSavingGovernor() {
+	PowerSaving::SetAutomatic({});
+}
+
+bool PowerSavingGovernor::Enabled() {
+	return OptionAdaptivePowerSaving.value();
+}
+
+void PowerSavingGovernor::setActive(bool active) {
+	if (!active) {
+		// Drop the unfinished window, it may include the throttled ticks.
+		_probeTimer.cancel();
+		_lagSum = 0;
+		_probes = 0;
+	} else if (!_probeTimer.isActive()) {
+		_expected = crl::now() + kProbeInterval;
+		_probeTimer.callEach(kProbeInterval);
+	}
+}
+
+void PowerSavingGovernor::probe() {
+	const auto now = crl::now();
+	_lagSum += std::max(now - _expected, crl::time(0));
+	_expected = now + kProbeInterval;
+	if (++_probes == kProbesInWindow) {
+		finishWindow();
+	}
+}
+
+void PowerSavingGovernor::finishWindow() {
+	const auto lag = _lagSum / _probes;
+	_lagSum = 0;
+	_probes = 0;
+	if (PowerSaving::ForceAll()) {
+		// Battery saving already disabled everything.
+		_idleWindows = 0;
+	} else if (lag > kBusyLag) {
+		_idleWindows = 0;
+		engage();
+	} else if (lag < kIdleLag && _engaged > 0) {
+		if (++_idleWindows == kIdleWindowsToRelease) {
+			_idleWindows = 0;
+			release();
+		}
+	} else {
+		_idleWindows = 0;
+	}
+}
+
+void PowerSavingGovernor::engage() {
+	const auto manual = PowerSaving::Current();
+	while (_engaged < int(kGovernedFlags.size())) {
+		const auto flag = kGovernedFlags[_engaged++];
+		if (!(manual & flag)) {
+			PowerSaving::SetAutomatic(PowerSaving::Automatic() | flag);
+			LOG(("Power Saving: Engaged %1 automatically, flags: %2."
+				).arg(uint32(flag)
+				).arg(PowerSaving::Automatic().value()));
+			return;
+		}
+	}
+}
+
+void PowerSavingGovernor::release() {
+	while (_engaged > 0) {
+		const auto flag = kGovernedFlags[--_engaged];
+		if (PowerSaving::Automatic() & flag) {
+			PowerSaving::SetAutomatic(PowerSaving::Automatic() & ~flag);
+			LOG(("Power Saving: Released %1 automatically, flags: %2."
+				).arg(uint32(flag)
+				).arg(PowerSaving::Automatic().value()));
+			return;
+		}
+	}
+}
+
+} // namespace Core
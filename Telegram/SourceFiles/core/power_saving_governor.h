@@ -0,0 +1,45 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/timer.h"
+
+namespace Core {
+
+extern const char kOptionAdaptivePowerSaving[];
+
+// Measures how late the main thread runs its timers and engages the
+// most expensive PowerSaving flags one by one while it stays overloaded.
+// The timers of an inactive app are throttled by the OS, so it measures
+// only while the app is active.
+class PowerSavingGovernor final {
+public:
+	explicit PowerSavingGovernor(rpl::producer<bool> appActive);
+	~PowerSavingGovernor();
+
+	[[nodiscard]] static bool Enabled();
+
+private:
+	void setActive(bool active);
+	void probe();
+	void finishWindow();
+	void engage();
+	void release();
+
+	base::Timer _probeTimer;
+	crl::time _expected = 0;
+	crl::time _lagSum = 0;
+	int _probes = 0;
+	int _idleWindows = 0;
+	int _engaged = 0;
+
+	rpl::lifetime _lifetime;
+
+};
+
+} // namespace Core
@@ -21,6 +21,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/local_url_handlers.h"
 #include "core/update_checker.h"
 #include "core/deadlock_detector.h"
+#include "core/stall_detector.h"
+#include "core/tracing.h"
 #include "base/timer.h"
 #include "base/concurrent_timer.h"
 #include "base/invoke_queued.h"
@@ -196,6 +198,10 @@ void Sandbox::launchApplication() {
 			_deadlockDetector = std::make_unique<PingThread>(this);
 		}
 #endif // !_DEBUG
+		Tracing::Start();
+		if (StallDetector::Enabled()) {
+			_stallDetector = std::make_unique<StallDetector>();
+		}
 
 		_application = std::make_unique<Application>();
 
@@ -591,6 +597,17 @@ bool Sandbox::notify(QObject *receiver, QEvent *e) {
 		return notifyOrInvoke(receiver, e);
 	}
 
+	const auto measureStall = _stallDetector
+		&& receiver
+		&& !_eventNestingLevel;
+	if (_stallDetector && receiver) {
+		_stallDetector->entered(receiver, e->type(), measureStall);
+	}
+	const auto stallGuard = gsl::finally([&] {
+		if (measureStall && _stallDetector) {
+			_stallDetector->finished();
+		}
+	});
 	const auto wrap = createEventNestingLevel();
 	if (e->type() == QEvent::UpdateRequest) {
 		const auto weak = QPointer<QObject>(receiver);
@@ -637,6 +654,8 @@ void Sandbox::closeApplication() {
 	SetLaunchState(LaunchState::QuitProcessed);
 
 	_application = nullptr;
+	_stallDetector = nullptr;
+	Tracing::Finish(cWorkingDir() + u"trace.json"_q);
 
 	_localServer.close();
 	for (const auto &localClient : base::take(_localClients)) {
@@ -20,6 +20,7 @@ class QLockFile;
 namespace Core {
 
 class UpdateChecker;
+class StallDetector;
 class Application;
 
 class Sandbox final
@@ -133,6 +134,7 @@ private:
 	rpl::event_stream<> _widgetUpdateRequests;
 
 	std::unique_ptr<QThread> _deadlockDetector;
+	std::unique_ptr<StallDetector> _stallDetector;
 
 };
 
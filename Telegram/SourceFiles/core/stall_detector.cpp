@@ -0,0 +1,105 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/stall_detector.h"
+
+#include "base/options.h"
+
+namespace Core {
+namespace {
+
+constexpr auto kStallThreshold = crl::time(50);
+constexpr auto kReportInterval = 10 * 60 * crl::time(1000);
+constexpr auto kReportTopCount = 10;
+
+base::options::toggle OptionStallDetector({
+	.id = kOptionStallDetector,
+	.name = "Log interface stalls",
+	.description = "Write the event receivers that block"
+		" the interface for longer than 50 ms to the log.",
+	.restartRequired = true,
+});
+
+} // namespace
+
+const char kOptionStallDetector[] = "stall-detector";
+
+StallDetector::StallDetector() = default;
+
+StallDetector::~StallDetector() {
+	report(crl::now());
+}
+
+bool StallDetector::Enabled() {
+	return OptionStallDetector.value();
+}
+
+void StallDetector::entered(
+		not_null<QObject*> receiver,
+		QEvent::Type type,
+		bool outermost) {
+	const auto loopLevel = QThread::currentThread()->loopLevel();
+	if (outermost) {
+		_className = receiver->metaObject()->className();
+		_type = type;
+		_started = crl::now();
+		_loopLevel = loopLevel;
+		_nestedLoop = false;
+	} else if (loopLevel > _loopLevel) {
+		// A modal loop inside the event handler is not a stall.
+		_nestedLoop = true;
+	}
+}
+
+void StallDetector::finished() {
+	if (!_started) {
+		return;
+	}
+	const auto now = crl::now();
+	const auto duration = now - base::take(_started);
+	if (duration >= kStallThreshold && !_nestedLoop) {
+		auto &stalls = _stalls[Key{ QByteArray(_className), _type }];
+		++stalls.count;
+		stalls.total += duration;
+		stalls.max = std::max(stalls.max, duration);
+	}
+	if (!_lastReport) {
+		_lastReport = now;
+	} else if (now - _lastReport >= kReportInterval) {
+		report(now);
+	}
+}
+
+void StallDetector::report(crl::time now) {
+	_lastReport = now;
+	if (_stalls.empty()) {
+		return;
+	}
+	auto list = std::vector<std::pair<Key, Stalls>>(
+		begin(_stalls),
+		end(_stalls));
+	_stalls.clear();
+
+	ranges::sort(list, ranges::greater(), [](const auto &entry) {
+		return entry.second.total;
+	});
+	if (list.size() > kReportTopCount) {
+		list.resize(kReportTopCount);
+	}
+	auto lines = QStringList();
+	for (const auto &[key, stalls] : list) {
+		lines.push_back(u"%1 (event %2): %3 times, %4 ms total, %5 ms max"_q
+			.arg(QString::fromLatin1(key.className))
+			.arg(int(key.type))
+			.arg(stalls.count)
+			.arg(stalls.total)
+			.arg(stalls.max));
+	}
+	LOG(("Stall Info: Slowest event receivers:\n%1").arg(lines.join('\n')));
+}
+
+} // namespace Core
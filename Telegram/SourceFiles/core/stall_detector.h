@@ -0,0 +1,59 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/flat_map.h"
+
+namespace Core {
+
+extern const char kOptionStallDetector[];
+
+// Measures main thread events entered right from the event loop
+// and logs the slowest receivers and event types once in a while.
+class StallDetector final {
+public:
+	StallDetector();
+	~StallDetector();
+
+	[[nodiscard]] static bool Enabled();
+
+	// Called for each main thread event, outermost is true for the ones
+	// entered right from the event loop, those are finished() later.
+	void entered(
+		not_null<QObject*> receiver,
+		QEvent::Type type,
+		bool outermost);
+	void finished();
+
+private:
+	struct Key {
+		QByteArray className;
+		QEvent::Type type = QEvent::None;
+
+		friend inline auto operator<=>(const Key &, const Key &) = default;
+		friend inline bool operator==(const Key &, const Key &) = default;
+	};
+	struct Stalls {
+		int count = 0;
+		crl::time total = 0;
+		crl::time max = 0;
+	};
+
+	void report(crl::time now);
+
+	base::flat_map<Key, Stalls> _stalls;
+	const char *_className = nullptr;
+	QEvent::Type _type = QEvent::None;
+	crl::time _started = 0;
+	crl::time _lastReport = 0;
+	int _loopLevel = 0;
+	bool _nestedLoop = false;
+
+};
+
+} // namespace Core
@@ -0,0 +1,146 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/tracing.h"
+
+#ifdef TDESKTOP_ENABLE_TRACING
+
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace Core::Tracing {
+namespace {
+
+constexpr auto kBufferSize = 64 * 1024;
+
+struct Event {
+	const char *name = nullptr;
+	int64 start = 0;
+	int64 value = 0; // Finish time for zones.
+	bool counter = false;
+};
+
+// Each thread writes only to its own ring, without locking.
+struct Buffer {
+	std::array<Event, kBufferSize> events;
+	std::atomic<uint64> written = 0;
+	int threadId = 0;
+};
+
+std::atomic<bool> Enabled = false;
+std::atomic<int> Writers = 0;
+QMutex BuffersMutex;
+std::vector<std::unique_ptr<Buffer>> Buffers;
+int LastThreadId = 0;
+const auto StartTime = std::chrono::steady_clock::now();
+
+[[nodiscard]] not_null<Buffer*> CurrentBuffer() {
+	// Buffers are never freed, threads may outlive Finish().
+	thread_local auto result = (Buffer*)nullptr;
+	if (!result) {
+		auto owned = std::make_unique<Buffer>();
+		result = owned.get();
+
+		QMutexLocker lock(&BuffersMutex);
+		owned->threadId = ++LastThreadId;
+		Buffers.push_back(std::move(owned));
+	}
+	return result;
+}
+
+void Push(Event event) {
+	// Finish() waits for the writers that passed the Enabled check.
+	Writers.fetch_add(1);
+	if (Enabled.load()) {
+		const auto buffer = CurrentBuffer();
+		const auto index = buffer->written.load(std::memory_order_relaxed);
+		buffer->events[index % kBufferSize] = event;
+		buffer->written.store(index + 1, std::memory_order_release);
+	}
+	Writers.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace
+
+void Start() {
+	Enabled = true;
+}
+
+void Finish(const QString &path) {
+	if (!Enabled.exchange(false)) {
+		return;
+	}
+	while (Writers.load(std::memory_order_acquire) > 0) {
+		std::this_thread::yield();
+	}
+	auto result = QByteArray();
+	result.append("{\"traceEvents\":[");
+	auto first = true;
+
+	QMutexLocker lock(&BuffersMutex);
+	for (const auto &buffer : Buffers) {
+		const auto written = buffer->written.load(std::memory_order_acquire);
+		const auto from = (written > kBufferSize)
+			? (written - kBufferSize)
+			: 0;
+		for (auto i = from; i != written; ++i) {
+			const auto &event = buffer->events[i % kBufferSize];
+			if (!first) {
+				result.append(',');
+			}
+			first = false;
+			if (event.counter) {
+				result.append(QString(
+					"{\"name\":\"%1\",\"ph\":\"C\",\"ts\":%2,\"pid\":1,"
+					"\"args\":{\"value\":%3}}"
+				).arg(event.name).arg(event.start).arg(event.value).toUtf8());
+			} else {
+				result.append(QString(
+					"{\"name\":\"%1\",\"ph\":\"X\",\"ts\":%2,\"dur\":%3,"
+					"\"pid\":1,\"tid\":%4}"
+				).arg(event.name
+				).arg(event.start
+				).arg(event.value - event.start
+				).arg(buffer->threadId).toUtf8());
+			}
+		}
+		buffer->written.store(0, std::memory_order_relaxed);
+	}
+	lock.unlock();
+
+	result.append("]}");
+	QFile f(path);
+	if (f.open(QIODevice::WriteOnly)) {
+		f.write(result);
+		LOG(("Tracing Info: Written %1 bytes to '%2'."
+			).arg(result.size()
+			).arg(path));
+	} else {
+		LOG(("Tracing Error: Could not write '%1'.").arg(path));
+	}
+}
+
+int64 Now() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now() - StartTime).count();
+}
+
+void AddZone(const char *name, int64 start, int64 finish) {
+	Push({ .name = name, .start = start, .value = finish });
+}
+
+void AddCounter(const char *name, int64 value) {
+	Push({ .name = name, .start = Now(), .value = value, .counter = true });
+}
+
+} // namespace Core::Tracing
+
+#endif // TDESKTOP_ENABLE_TRACING
@@ -0,0 +1,62 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+// Scoped zones and counters in the Chrome trace event format, so that
+// the output can be opened in Perfetto or chrome://tracing.
+//
+// Compiled only with TDESKTOP_ENABLE_TRACING defined, otherwise all the
+// TRACE_* macros expand to nothing. Names must be string literals.
+
+namespace Core::Tracing {
+
+#ifdef TDESKTOP_ENABLE_TRACING
+
+void Start();
+void Finish(const QString &path);
+
+[[nodiscard]] int64 Now();
+void AddZone(const char *name, int64 start, int64 finish);
+void AddCounter(const char *name, int64 value);
+
+class Zone final {
+public:
+	explicit Zone(const char *name) : _name(name), _start(Now()) {
+	}
+	Zone(const Zone &other) = delete;
+	Zone &operator=(const Zone &other) = delete;
+	~Zone() {
+		AddZone(_name, _start, Now());
+	}
+
+private:
+	const char *_name = nullptr;
+	int64 _start = 0;
+
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) \
+	const auto TRACE_CONCAT(TracingZone, __LINE__) = ::Core::Tracing::Zone(name)
+#define TRACE_COUNTER(name, value) \
+	::Core::Tracing::AddCounter(name, int64(value))
+
+#else // TDESKTOP_ENABLE_TRACING
+
+inline void Start() {
+}
+inline void Finish(const QString &path) {
+}
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+
+#endif // TDESKTOP_ENABLE_TRACING
+
+} // namespace Core::Tracing
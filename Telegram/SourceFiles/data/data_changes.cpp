@@ -23,7 +23,8 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
-		_stream.fire({ data, flags });
+		fire({ data, flags });
+		_dataStreams.remove(data);
 	} else {
 		_updates[data] |= flags;
 	}
@@ -41,6 +42,19 @@ void Changes::Manager<DataType, UpdateType>::sendRealtimeNotifications(
 	}
 }
 
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::fire(UpdateType &&update) {
+	const auto &[data, flags] = update;
+	const auto i = _dataStreams.find(data);
+
+	// Keep the stream alive if a subscriber drops it while firing.
+	const auto stream = (i != end(_dataStreams)) ? i->second : nullptr;
+	_stream.fire_copy(update);
+	if (stream) {
+		stream->fire(std::move(update));
+	}
+}
+
 template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		Flags flags) const {
@@ -54,10 +68,13 @@ template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		not_null<DataType*> data,
 		Flags flags) const {
-	return _stream.events(
+	auto &stream = _dataStreams[data];
+	if (!stream) {
+		stream = std::make_shared<rpl::event_stream<UpdateType>>();
+	}
+	return stream->events(
 	) | rpl::filter([=](const UpdateType &update) {
-		const auto &[updateData, updateFlags] = update;
-		return (updateData == data) && (updateFlags & flags);
+		return (update.flags & flags);
 	});
 }
 
@@ -79,12 +96,13 @@ rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::flagsValue(
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::drop(not_null<DataType*> data) {
 	_updates.remove(data);
+	_dataStreams.remove(data);
 }
 
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	for (const auto &[data, flags] : base::take(_updates)) {
-		_stream.fire({ data, flags });
+		fire({ data, flags });
 	}
 }
 
@@ -374,11 +374,17 @@ private:
 		void sendRealtimeNotifications(
 			not_null<DataType*> data,
 			Flags flags);
+		void fire(UpdateType &&update);
 
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
 
+		// Subscribers to a single object don't filter the whole stream.
+		mutable base::flat_map<
+			not_null<DataType*>,
+			std::shared_ptr<rpl::event_stream<UpdateType>>> _dataStreams;
+
 	};
 
 	void scheduleNotifications();
@@ -306,6 +306,14 @@ bool ChatFilter::contains(not_null<History*> history) const {
 		|| _always.contains(history);
 }
 
+bool ChatFilter::dependsOn(
+		not_null<History*> history,
+		Flags rules) const {
+	return (_flags & rules)
+		&& !_never.contains(history)
+		&& !_always.contains(history);
+}
+
 ChatFilters::ChatFilters(not_null<Session*> owner)
 : _owner(owner)
 , _moreChatsTimer([=] { checkLoadMoreChatsLists(); }) {
@@ -837,8 +845,17 @@ bool ChatFilters::loadNextExceptions(bool chatsListLoaded) {
 	return true;
 }
 
-void ChatFilters::refreshHistory(not_null<History*> history) {
-	if (history->inChatList() && !list().empty()) {
+void ChatFilters::refreshHistory(
+		not_null<History*> history,
+		ChatFilter::Flags rules) {
+	if (!history->inChatList()) {
+		return;
+	}
+	const auto affected = ranges::any_of(_list, [&](
+			const ChatFilter &filter) {
+		return filter.id() && filter.dependsOn(history, rules);
+	});
+	if (affected) {
 		_owner->refreshChatListEntry(history);
 	}
 }
@@ -80,6 +80,12 @@ public:
 
 	[[nodiscard]] bool contains(not_null<History*> history) const;
 
+	// Whether contains(history) may change if only the history
+	// properties checked by the given rule flags have changed.
+	[[nodiscard]] bool dependsOn(
+		not_null<History*> history,
+		Flags rules) const;
+
 private:
 	FilterId _id = 0;
 	QString _title;
@@ -143,7 +149,9 @@ public:
 
 	bool loadNextExceptions(bool chatsListLoaded);
 
-	void refreshHistory(not_null<History*> history);
+	void refreshHistory(
+		not_null<History*> history,
+		ChatFilter::Flags rules);
 
 	[[nodiscard]] not_null<Dialogs::MainList*> chatsList(FilterId filterId);
 	void clear();
@@ -88,6 +88,13 @@ enum class FileType {
 		|| (size.width() * size.height() > kReadAreaLimit)) {
 		return QImage();
 	}
+	const auto limit = QSize(
+		kWallPaperThumbnailLimit,
+		kWallPaperThumbnailLimit);
+	if (size.width() > limit.width() || size.height() > limit.height()) {
+		// Let the decoder downscale, JPEG skips most of the work this way.
+		reader.setScaledSize(size.scaled(limit, Qt::KeepAspectRatio));
+	}
 	auto result = reader.read();
 	if (!result.width() || !result.height()) {
 		return QImage();
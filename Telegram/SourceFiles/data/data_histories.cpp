@@ -32,6 +32,7 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kMaxReadRequestsInFlight = 4;
 
 } // namespace
 
@@ -135,9 +136,19 @@ void Histories::unloadAll() {
 }
 
 void Histories::clearAll() {
+	_openedInWindows.clear();
 	_map.clear();
 }
 
+void Histories::setOpenedInWindow(not_null<History*> history, bool opened) {
+	if (opened) {
+		++_openedInWindows[history];
+	} else if (const auto i = _openedInWindows.find(history)
+		; i != end(_openedInWindows) && !--i->second) {
+		_openedInWindows.erase(i);
+	}
+}
+
 void Histories::readInbox(not_null<History*> history) {
 	DEBUG_LOG(("Reading: readInbox called."));
 	if (history->lastServerMessageKnown()) {
@@ -572,13 +583,28 @@ void Histories::sendReadRequests() {
 	}
 	const auto now = crl::now();
 	auto next = std::optional<crl::time>();
+
+	// Marking a whole folder as read shouldn't send all the requests
+	// at once, the rest are sent when the ones in flight are finished.
+	// The chats opened in the windows are never kept behind the cap.
+	auto inFlight = int(ranges::count_if(_states, [](const auto &pair) {
+		return pair.second.sentReadTill && !pair.second.sentReadDone;
+	}));
 	for (auto &[history, state] : _states) {
 		if (!state.willReadTill) {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
 		} else if (state.willReadWhen <= now) {
+			if (inFlight >= kMaxReadRequestsInFlight
+				&& !_openedInWindows.contains(history)) {
+				DEBUG_LOG(("Reading: waiting for requests in flight."));
+				continue;
+			}
 			DEBUG_LOG(("Reading: sending with till %1."
 				).arg(state.willReadTill.bare));
+			if (!state.sentReadTill || state.sentReadDone) {
+				++inFlight;
+			}
 			sendReadRequest(history, state);
 		} else if (!next || *next > state.willReadWhen) {
 			DEBUG_LOG(("Reading: scheduling for later send."));
@@ -57,6 +57,9 @@ public:
 	void unloadAll();
 	void clearAll();
 
+	// Read requests of the histories opened in windows skip the cap.
+	void setOpenedInWindow(not_null<History*> history, bool opened);
+
 	void readInbox(not_null<History*> history);
 	void readInboxTill(not_null<HistoryItem*> item);
 	void readInboxTill(not_null<History*> history, MsgId tillId);
@@ -212,6 +215,7 @@ private:
 
 	std::unordered_map<PeerId, std::unique_ptr<History>> _map;
 	base::flat_map<not_null<History*>, State> _states;
+	base::flat_map<not_null<History*>, int> _openedInWindows;
 	base::flat_map<int, not_null<History*>> _historyByRequest;
 	int _requestAutoincrement = 0;
 	base::Timer _readRequestsTimer;
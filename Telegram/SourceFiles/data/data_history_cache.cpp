@@ -0,0 +1,214 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_history_cache.h"
+
+#include "api/api_updates.h"
+#include "base/options.h"
+#include "data/data_channel.h"
+#include "data/data_session.h"
+#include "history/history.h"
+#include "main/main_session.h"
+#include "storage/cache/storage_cache_database.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kHistoryCacheTag = 0x0000050000000000ULL;
+constexpr auto kVersion = 1;
+constexpr auto kMaxCachedSize = 1024 * 1024;
+
+base::options::toggle LocalHistoryCache({
+	.id = kOptionLocalHistoryCache,
+	.name = "Local history cache",
+	.description = "Keep the last messages of opened chats on disk and"
+		" show them after restart if nothing changed in the chat.",
+});
+
+[[nodiscard]] PeerId ChatPeerId(const MTPChat &chat) {
+	return chat.match([](const MTPDchat &data) {
+		return peerFromChat(data.vid().v);
+	}, [](const MTPDchatForbidden &data) {
+		return peerFromChat(data.vid().v);
+	}, [](const MTPDchatEmpty &data) {
+		return peerFromChat(data.vid().v);
+	}, [](const MTPDchannel &data) {
+		return peerFromChannel(data.vid().v);
+	}, [](const MTPDchannelForbidden &data) {
+		return peerFromChannel(data.vid().v);
+	});
+}
+
+[[nodiscard]] PeerId UserPeerId(const MTPUser &user) {
+	return user.match([](const auto &data) {
+		return peerFromUser(data.vid().v);
+	});
+}
+
+} // namespace
+
+const char kOptionLocalHistoryCache[] = "local-history-cache";
+
+Storage::Cache::Key HistoryCacheKey(PeerId peerId) {
+	return Storage::Cache::Key{ kHistoryCacheTag, peerId.value };
+}
+
+HistoryCache::HistoryCache(not_null<Session*> owner)
+: _owner(owner) {
+}
+
+bool HistoryCache::Enabled() {
+	return LocalHistoryCache.value();
+}
+
+std::optional<int32> HistoryCache::currentPts(
+		not_null<History*> history) const {
+	if (const auto channel = history->peer->asChannel()) {
+		return channel->ptsInited()
+			? channel->pts()
+			: std::optional<int32>();
+	}
+	const auto &updates = _owner->session().updates();
+	return updates.requestingDifference()
+		? std::optional<int32>()
+		: updates.pts();
+}
+
+void HistoryCache::save(
+		not_null<History*> history,
+		const MTPmessages_Messages &result) {
+	if (!Enabled()) {
+		return;
+	}
+	const auto pts = result.match([&](
+			const MTPDmessages_channelMessages &data) {
+		return std::make_optional(data.vpts().v);
+	}, [&](const MTPDmessages_messagesNotModified &) {
+		return std::optional<int32>();
+	}, [&](const auto &) {
+		return currentPts(history);
+	});
+	const auto key = HistoryCacheKey(history->peer->id);
+	if (!pts) {
+		_owner->cache().remove(key);
+		return;
+	}
+	auto buffer = mtpBuffer();
+	buffer.reserve(2 + result.innerLength() / sizeof(mtpPrime));
+	buffer.push_back(kVersion);
+	buffer.push_back(*pts);
+	result.write(buffer);
+	const auto size = buffer.size() * int(sizeof(mtpPrime));
+	if (size > kMaxCachedSize) {
+		_owner->cache().remove(key);
+		return;
+	}
+	_owner->cache().put(key, QByteArray(
+		reinterpret_cast<const char*>(buffer.constData()),
+		size));
+}
+
+void HistoryCache::load(
+		not_null<History*> history,
+		Fn<void(std::optional<MTPmessages_Messages>)> done) {
+	Expects(done != nullptr);
+
+	if (!Enabled()) {
+		done(std::nullopt);
+		return;
+	}
+	const auto weak = base::make_weak(history);
+	_owner->cache().get(HistoryCacheKey(history->peer->id), [=](
+			QByteArray &&value) {
+		crl::on_main(weak, [=, value = std::move(value)] {
+			done(parse(history, value));
+		});
+	});
+}
+
+std::optional<MTPmessages_Messages> HistoryCache::parse(
+		not_null<History*> history,
+		const QByteArray &value) const {
+	if (value.isEmpty() || (value.size() % sizeof(mtpPrime))) {
+		return std::nullopt;
+	}
+	auto buffer = mtpBuffer(value.size() / sizeof(mtpPrime));
+	memcpy(buffer.data(), value.constData(), value.size());
+	auto from = buffer.constData();
+	const auto end = from + buffer.size();
+	if (end - from < 2 || *from++ != kVersion) {
+		return std::nullopt;
+	}
+	const auto pts = *from++;
+	if (currentPts(history) != pts) {
+		DEBUG_LOG(("History Cache: Outdated slice for %1."
+			).arg(history->peer->id.value));
+		return std::nullopt;
+	}
+	auto result = MTPmessages_Messages();
+	if (!result.read(from, end) || from != end) {
+		LOG(("History Cache Error: Could not read slice for %1."
+			).arg(history->peer->id.value));
+		return std::nullopt;
+	}
+
+	// Peers known by now have newer data than the cached ones.
+	const auto unknown = [&](PeerId id) {
+		return !_owner->peerLoaded(id);
+	};
+	const auto filterChats = [&](const MTPVector<MTPChat> &chats) {
+		auto result = QVector<MTPChat>();
+		for (const auto &chat : chats.v) {
+			if (unknown(ChatPeerId(chat))) {
+				result.push_back(chat);
+			}
+		}
+		return MTP_vector<MTPChat>(std::move(result));
+	};
+	const auto filterUsers = [&](const MTPVector<MTPUser> &users) {
+		auto result = QVector<MTPUser>();
+		for (const auto &user : users.v) {
+			if (unknown(UserPeerId(user))) {
+				result.push_back(user);
+			}
+		}
+		return MTP_vector<MTPUser>(std::move(result));
+	};
+
+	// Keep the slice type, pts and count, so that the cached slice
+	// is processed by messagesReceived() the same way as the live one.
+	using Result = std::optional<MTPmessages_Messages>;
+	return result.match([&](const MTPDmessages_messages &data) -> Result {
+		return MTP_messages_messages(
+			data.vmessages(),
+			filterChats(data.vchats()),
+			filterUsers(data.vusers()));
+	}, [&](const MTPDmessages_messagesSlice &data) -> Result {
+		return MTP_messages_messagesSlice(
+			data.vflags(),
+			data.vcount(),
+			MTP_int(data.vnext_rate().value_or_empty()),
+			MTP_int(data.voffset_id_offset().value_or_empty()),
+			data.vmessages(),
+			filterChats(data.vchats()),
+			filterUsers(data.vusers()));
+	}, [&](const MTPDmessages_channelMessages &data) -> Result {
+		return MTP_messages_channelMessages(
+			data.vflags(),
+			data.vpts(),
+			data.vcount(),
+			MTP_int(data.voffset_id_offset().value_or_empty()),
+			data.vmessages(),
+			data.vtopics(),
+			filterChats(data.vchats()),
+			filterUsers(data.vusers()));
+	}, [&](const MTPDmessages_messagesNotModified &) -> Result {
+		return std::nullopt;
+	});
+}
+
+} // namespace Data
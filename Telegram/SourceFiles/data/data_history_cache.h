@@ -0,0 +1,53 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class History;
+
+namespace Storage::Cache {
+struct Key;
+} // namespace Storage::Cache
+
+namespace Data {
+
+class Session;
+
+extern const char kOptionLocalHistoryCache[];
+
+[[nodiscard]] Storage::Cache::Key HistoryCacheKey(PeerId peerId);
+
+// Keeps the last slice received from the end of a history in the local
+// cache database, so that after a restart the chat can be shown without
+// a messages.getHistory request while its pts didn't change.
+class HistoryCache final {
+public:
+	explicit HistoryCache(not_null<Session*> owner);
+
+	[[nodiscard]] static bool Enabled();
+
+	void save(
+		not_null<History*> history,
+		const MTPmessages_Messages &result);
+
+	// Calls done(std::nullopt) if there is no up to date slice.
+	void load(
+		not_null<History*> history,
+		Fn<void(std::optional<MTPmessages_Messages>)> done);
+
+private:
+	[[nodiscard]] std::optional<int32> currentPts(
+		not_null<History*> history) const;
+	[[nodiscard]] std::optional<MTPmessages_Messages> parse(
+		not_null<History*> history,
+		const QByteArray &value) const;
+
+	const not_null<Session*> _owner;
+
+};
+
+} // namespace Data
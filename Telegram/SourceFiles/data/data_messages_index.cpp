@@ -0,0 +1,102 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_messages_index.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMinCapacity = 1024;
+
+} // namespace
+
+HistoryItem *MessagesIndex::find(FullMsgId id) const {
+	return _slots.empty() ? nullptr : _slots[findSlot(id)].item;
+}
+
+void MessagesIndex::insert(FullMsgId id, not_null<HistoryItem*> item) {
+	if (4 * (_count + 1) > 3 * int(_slots.size())) {
+		rehash(std::max(kMinCapacity, int(_slots.size()) * 2));
+	}
+	auto &slot = _slots[findSlot(id)];
+	if (!slot.item) {
+		slot.id = id;
+		++_count;
+	}
+	slot.item = item;
+}
+
+void MessagesIndex::remove(FullMsgId id) {
+	if (_slots.empty()) {
+		return;
+	}
+	const auto mask = int(_slots.size()) - 1;
+	auto hole = findSlot(id);
+	if (!_slots[hole].item) {
+		return;
+	}
+	--_count;
+
+	// Backward shift deletion keeps the probe chains unbroken.
+	for (auto index = (hole + 1) & mask
+		; _slots[index].item
+		; index = (index + 1) & mask) {
+		const auto ideal = int(Hash(_slots[index].id) & mask);
+		if (((index - ideal) & mask) >= ((index - hole) & mask)) {
+			_slots[hole] = _slots[index];
+			hole = index;
+		}
+	}
+	_slots[hole] = Slot();
+
+	if (int(_slots.size()) > kMinCapacity && 8 * _count < int(_slots.size())) {
+		rehash(int(_slots.size()) / 2);
+	}
+}
+
+void MessagesIndex::reserve(int count) {
+	auto capacity = std::max(kMinCapacity, int(_slots.size()));
+	while (4 * (_count + count) > 3 * capacity) {
+		capacity *= 2;
+	}
+	if (capacity != int(_slots.size())) {
+		rehash(capacity);
+	}
+}
+
+void MessagesIndex::clear() {
+	_slots = std::vector<Slot>();
+	_count = 0;
+}
+
+uint64 MessagesIndex::Hash(FullMsgId id) {
+	const auto value = (id.peer.value * 0x9E3779B97F4A7C15ULL)
+		^ (uint64(id.msg.bare) * 0xC2B2AE3D27D4EB4FULL);
+	return value ^ (value >> 29);
+}
+
+int MessagesIndex::findSlot(FullMsgId id) const {
+	const auto mask = int(_slots.size()) - 1;
+	auto index = int(Hash(id) & mask);
+	while (_slots[index].item && _slots[index].id != id) {
+		index = (index + 1) & mask;
+	}
+	return index;
+}
+
+void MessagesIndex::rehash(int capacity) {
+	Expects(!(capacity & (capacity - 1)));
+
+	auto was = std::exchange(_slots, std::vector<Slot>(capacity));
+	for (const auto &slot : was) {
+		if (slot.item) {
+			_slots[findSlot(slot.id)] = slot;
+		}
+	}
+}
+
+} // namespace Data
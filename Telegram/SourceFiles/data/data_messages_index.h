@@ -0,0 +1,47 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "data/data_msg_id.h"
+
+class HistoryItem;
+
+namespace Data {
+
+// All registered messages by FullMsgId in one open addressing table,
+// so a lookup is a single probe sequence over a contiguous array.
+class MessagesIndex final {
+public:
+	[[nodiscard]] HistoryItem *find(FullMsgId id) const;
+	void insert(FullMsgId id, not_null<HistoryItem*> item);
+	void remove(FullMsgId id);
+	void clear();
+
+	// Grows once so that inserting 'count' more items won't rehash.
+	void reserve(int count);
+
+	[[nodiscard]] int size() const {
+		return _count;
+	}
+
+private:
+	struct Slot {
+		FullMsgId id;
+		HistoryItem *item = nullptr;
+	};
+
+	[[nodiscard]] static uint64 Hash(FullMsgId id);
+	[[nodiscard]] int findSlot(FullMsgId id) const;
+	void rehash(int capacity);
+
+	std::vector<Slot> _slots;
+	int _count = 0;
+
+};
+
+} // namespace Data
@@ -0,0 +1,166 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_search_index.h"
+
+#include "base/options.h"
+#include "data/data_session.h"
+#include "history/history.h"
+#include "history/history_item.h"
+#include "ui/text/text_utilities.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMaxWordsPerMessage = 256;
+
+base::options::toggle LocalMessagesSearch({
+	.id = kOptionLocalMessagesSearch,
+	.name = "Local messages search",
+	.description = "Index the text of loaded messages and show matches"
+		" from it while the in-chat search request is in progress.",
+});
+
+[[nodiscard]] std::vector<QString> ItemWords(
+		not_null<HistoryItem*> item) {
+	const auto &text = item->originalText().text;
+	if (text.isEmpty()) {
+		return {};
+	}
+	auto words = TextUtilities::PrepareSearchWords(text);
+	auto result = std::vector<QString>(
+		std::make_move_iterator(words.begin()),
+		std::make_move_iterator(words.end()));
+	ranges::sort(result);
+	result.erase(ranges::unique(result), end(result));
+	if (int(result.size()) > kMaxWordsPerMessage) {
+		result.resize(kMaxWordsPerMessage);
+	}
+	return result;
+}
+
+} // namespace
+
+const char kOptionLocalMessagesSearch[] = "local-messages-search";
+
+SearchIndex::SearchIndex() = default;
+
+SearchIndex::~SearchIndex() = default;
+
+bool SearchIndex::Enabled() {
+	return LocalMessagesSearch.value();
+}
+
+void SearchIndex::add(not_null<HistoryItem*> item) {
+	if (!Enabled() || _words.contains(item)) {
+		return;
+	}
+	auto words = ItemWords(item);
+	if (words.empty()) {
+		return;
+	}
+	auto &index = _histories[item->history()];
+	for (const auto &word : words) {
+		index[word].emplace(item);
+	}
+	_words.emplace(item, std::move(words));
+}
+
+void SearchIndex::refresh(not_null<HistoryItem*> item) {
+	remove(item);
+
+	// Items still being constructed are added on registerMessage().
+	const auto registered = item->history()->owner().message(
+		item->fullId());
+	if (registered == item) {
+		add(item);
+	}
+}
+
+void SearchIndex::remove(not_null<HistoryItem*> item) {
+	const auto i = _words.find(item);
+	if (i == end(_words)) {
+		return;
+	}
+	const auto j = _histories.find(item->history());
+	if (j != end(_histories)) {
+		auto &index = j->second;
+		for (const auto &word : i->second) {
+			const auto k = index.find(word);
+			if (k != end(index)) {
+				k->second.erase(item);
+				if (k->second.empty()) {
+					index.erase(k);
+				}
+			}
+		}
+		if (index.empty()) {
+			_histories.erase(j);
+		}
+	}
+	_words.erase(i);
+}
+
+void SearchIndex::clear() {
+	_histories.clear();
+	_words.clear();
+}
+
+MessageIdsList SearchIndex::search(
+		not_null<History*> history,
+		const QString &query,
+		int limit) const {
+	const auto i = _histories.find(history);
+	if (i == end(_histories)) {
+		return {};
+	}
+	const auto &index = i->second;
+	auto found = std::optional<std::vector<not_null<HistoryItem*>>>();
+	for (const auto &word : TextUtilities::PrepareSearchWords(query)) {
+		auto matched = std::vector<not_null<HistoryItem*>>();
+		for (auto j = index.lower_bound(word); j != end(index); ++j) {
+			if (!j->first.startsWith(word)) {
+				break;
+			}
+			matched.insert(end(matched), begin(j->second), end(j->second));
+		}
+		ranges::sort(matched);
+		matched.erase(ranges::unique(matched), end(matched));
+		if (found) {
+			auto common = std::vector<not_null<HistoryItem*>>();
+			ranges::set_intersection(
+				*found,
+				matched,
+				std::back_inserter(common));
+			matched = std::move(common);
+		}
+		if (matched.empty()) {
+			return {};
+		}
+		found = std::move(matched);
+	}
+	if (!found) {
+		return {};
+	}
+	auto &items = *found;
+	items.erase(ranges::remove_if(items, [](not_null<HistoryItem*> item) {
+		return !item->isRegular();
+	}), end(items));
+	ranges::sort(items, ranges::greater(), [](not_null<HistoryItem*> item) {
+		return item->id;
+	});
+	if (int(items.size()) > limit) {
+		items.resize(limit);
+	}
+	return ranges::views::all(
+		items
+	) | ranges::views::transform([](not_null<HistoryItem*> item) {
+		return item->fullId();
+	}) | ranges::to<MessageIdsList>();
+}
+
+} // namespace Data
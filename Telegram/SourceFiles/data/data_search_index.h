@@ -0,0 +1,48 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class History;
+class HistoryItem;
+
+namespace Data {
+
+extern const char kOptionLocalMessagesSearch[];
+
+// Inverted index of the words of all messages loaded in the session,
+// used to show local search results before the server responds.
+class SearchIndex final {
+public:
+	SearchIndex();
+	~SearchIndex();
+
+	[[nodiscard]] static bool Enabled();
+
+	void add(not_null<HistoryItem*> item);
+	void refresh(not_null<HistoryItem*> item);
+	void remove(not_null<HistoryItem*> item);
+	void clear();
+
+	// Newest first, only messages that have server ids.
+	[[nodiscard]] MessageIdsList search(
+		not_null<History*> history,
+		const QString &query,
+		int limit) const;
+
+private:
+	// Messages are added one by one while the history slices are loaded,
+	// so the per-message containers must not be sorted vectors.
+	using Postings = std::unordered_set<not_null<HistoryItem*>>;
+	using Words = std::map<QString, Postings>;
+
+	base::flat_map<not_null<History*>, Words> _histories;
+	std::unordered_map<not_null<HistoryItem*>, std::vector<QString>> _words;
+
+};
+
+} // namespace Data
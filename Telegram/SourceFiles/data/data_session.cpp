@@ -58,6 +58,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_poll.h"
 #include "data/data_replies_list.h"
 #include "data/data_chat_filters.h"
+#include "data/data_search_index.h"
 #include "data/data_send_action.h"
 #include "data/data_message_reactions.h"
 #include "data/data_emoji_statuses.h"
@@ -69,6 +70,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_streaming.h"
 #include "data/data_media_rotation.h"
 #include "data/data_histories.h"
+#include "data/data_history_cache.h"
 #include "data/data_peer_values.h"
 #include "data/data_premium_limits.h"
 #include "data/data_forum.h"
@@ -98,6 +100,9 @@ const auto SmallLevels = "sa"_q;
 const auto ThumbnailLevels = "mbsa"_q;
 const auto LargeLevels = "ydxcwmbsa"_q;
 
+// Coalesce frequent item changes, like reactions of popular posts.
+constexpr auto kItemDataChangeDelay = crl::time(100);
+
 void CheckForSwitchInlineButton(not_null<HistoryItem*> item) {
 	if (item->out() || !item->hasSwitchInlineButton()) {
 		return;
@@ -255,13 +260,16 @@ Session::Session(not_null<Main::Session*> session)
 , _selfDestructTimer([=] { checkSelfDestructItems(); })
 , _pollsClosingTimer([=] { checkPollsClosings(); })
 , _watchForOfflineTimer([=] { checkLocalUsersWentOffline(); })
+, _itemDataChangesTimer([=] { sendItemDataChangesDelayed(); })
 , _groups(this)
 , _chatsFilters(std::make_unique<ChatFilters>(this))
 , _cloudThemes(std::make_unique<CloudThemes>(session))
 , _sendActionManager(std::make_unique<SendActionManager>())
 , _streaming(std::make_unique<Streaming>(this))
 , _mediaRotation(std::make_unique<MediaRotation>())
+, _searchIndex(std::make_unique<SearchIndex>())
 , _histories(std::make_unique<Histories>(this))
+, _historyCache(std::make_unique<HistoryCache>(this))
 , _stickers(std::make_unique<Stickers>(this))
 , _reactions(std::make_unique<Reactions>(this))
 , _emojiStatuses(std::make_unique<EmojiStatuses>(this))
@@ -399,7 +407,8 @@ void Session::clear() {
 	_session->scheduledMessages().clear();
 	_session->sponsoredMessages().clear();
 	_dependentMessages.clear();
-	base::take(_messages);
+	_messages.clear();
+	_searchIndex->clear();
 	base::take(_nonChannelMessages);
 	_messageByRandomId.clear();
 	_sentMessagesData.clear();
@@ -1325,7 +1334,10 @@ void Session::chatsListDone(Data::Folder *folder) {
 
 void Session::userIsBotChanged(not_null<UserData*> user) {
 	if (const auto history = this->history(user)) {
-		chatsFilters().refreshHistory(history);
+		using Flag = ChatFilter::Flag;
+		chatsFilters().refreshHistory(
+			history,
+			Flag::Bots | Flag::Contacts | Flag::NonContacts);
 	}
 	_userIsBotChanges.fire_copy(user);
 }
@@ -1649,14 +1661,15 @@ rpl::producer<not_null<HistoryItem*>> Session::newItemAdded() const {
 }
 
 HistoryItem *Session::changeMessageId(PeerId peerId, MsgId wasId, MsgId nowId) {
-	const auto list = messagesListForInsert(peerId);
-	const auto i = list->find(wasId);
-	if (i == list->end()) {
+	const auto item = _messages.find({ peerId, wasId });
+	if (!item) {
 		return nullptr;
 	}
-	const auto item = i->second;
-	list->erase(i);
-	const auto &[j, ok] = list->emplace(nowId, item);
+	_messages.remove({ peerId, wasId });
+	const auto ok = !_messages.find({ peerId, nowId });
+	if (ok) {
+		_messages.insert({ peerId, nowId }, item);
+	}
 
 	if (!peerIsChannel(peerId)) {
 		if (IsServerMsgId(wasId)) {
@@ -1815,6 +1828,21 @@ void Session::notifyItemDataChange(not_null<HistoryItem*> item) {
 	_itemDataChanges.fire_copy(item);
 }
 
+void Session::notifyItemDataChangeDelayed(not_null<HistoryItem*> item) {
+	_itemDataChangesDelayed.emplace(item->fullId());
+	if (!_itemDataChangesTimer.isActive()) {
+		_itemDataChangesTimer.callOnce(kItemDataChangeDelay);
+	}
+}
+
+void Session::sendItemDataChangesDelayed() {
+	for (const auto &id : base::take(_itemDataChangesDelayed)) {
+		if (const auto item = message(id)) {
+			notifyItemDataChange(item);
+		}
+	}
+}
+
 rpl::producer<not_null<HistoryItem*>> Session::itemDataChanges() const {
 	return _itemDataChanges.events();
 }
@@ -2331,7 +2359,8 @@ void Session::updateEditedMessage(const MTPMessage &data) {
 void Session::processMessages(
 		const QVector<MTPMessage> &data,
 		NewMessageType type) {
-	auto indices = base::flat_map<uint64, int>();
+	auto indices = std::vector<std::pair<uint64, int>>();
+	indices.reserve(data.size());
 	for (int i = 0, l = data.size(); i != l; ++i) {
 		const auto &message = data[i];
 		if (message.type() == mtpc_message) {
@@ -2343,8 +2372,9 @@ void Session::processMessages(
 			}
 		}
 		const auto id = IdFromMessage(message); // Only 32 bit values here.
-		indices.emplace((uint64(uint32(id.bare)) << 32) | uint64(i), i);
+		indices.emplace_back((uint64(uint32(id.bare)) << 32) | uint64(i), i);
 	}
+	ranges::sort(indices);
 	for (const auto &[position, index] : indices) {
 		addNewMessage(
 			data[index],
@@ -2380,30 +2410,26 @@ void Session::processExistingMessages(
 	});
 }
 
-const Session::Messages *Session::messagesList(PeerId peerId) const {
-	const auto i = _messages.find(peerId);
-	return (i != end(_messages)) ? &i->second : nullptr;
-}
-
-auto Session::messagesListForInsert(PeerId peerId)
--> not_null<Messages*> {
-	return &_messages[peerId];
-}
-
 void Session::registerMessage(not_null<HistoryItem*> item) {
 	const auto peerId = item->history()->peer->id;
-	const auto list = messagesListForInsert(peerId);
 	const auto itemId = item->id;
-	const auto i = list->find(itemId);
-	if (i != list->end()) {
+	if (const auto existing = _messages.find({ peerId, itemId })) {
 		LOG(("App Error: Trying to re-registerMessage()."));
-		i->second->destroy();
+		existing->destroy();
 	}
-	list->emplace(itemId, item);
+	_messages.insert({ peerId, itemId }, item);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.emplace(itemId, item);
 	}
+	_searchIndex->add(item);
+}
+
+void Session::reserveMessages(PeerId peerId, int count) {
+	_messages.reserve(count);
+	if (!peerIsChannel(peerId)) {
+		_nonChannelMessages.reserve(_nonChannelMessages.size() + count);
+	}
 }
 
 void Session::registerMessageTTL(TimeId when, not_null<HistoryItem*> item) {
@@ -2460,18 +2486,16 @@ void Session::checkTTLs() {
 void Session::processMessagesDeleted(
 		PeerId peerId,
 		const QVector<MTPint> &data) {
-	const auto list = messagesList(peerId);
 	const auto affected = historyLoaded(peerId);
-	if (!list && !affected) {
+	if (!_messages.size() && !affected) {
 		return;
 	}
 
 	auto historiesToCheck = base::flat_set<not_null<History*>>();
 	for (const auto &messageId : data) {
-		const auto i = list ? list->find(messageId.v) : Messages::iterator();
-		if (list && i != list->end()) {
-			const auto history = i->second->history();
-			i->second->destroy();
+		if (const auto item = _messages.find({ peerId, messageId.v })) {
+			const auto history = item->history();
+			item->destroy();
 			if (!history->chatListMessageKnown()) {
 				historiesToCheck.emplace(history);
 			}
@@ -2535,7 +2559,8 @@ void Session::unregisterMessage(not_null<HistoryItem*> item) {
 			++i;
 		}
 	}
-	messagesListForInsert(peerId)->erase(itemId);
+	_messages.remove({ peerId, itemId });
+	_searchIndex->remove(item);
 
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.erase(itemId);
@@ -2567,13 +2592,7 @@ HistoryItem *Session::message(PeerId peerId, MsgId itemId) const {
 		return nullptr;
 	}
 
-	const auto data = messagesList(peerId);
-	if (!data) {
-		return nullptr;
-	}
-
-	const auto i = data->find(itemId);
-	return (i != data->end()) ? i->second.get() : nullptr;
+	return _messages.find({ peerId, itemId });
 }
 
 HistoryItem *Session::message(
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_main_list.h"
 #include "data/data_groups.h"
 #include "data/data_cloud_file.h"
+#include "data/data_messages_index.h"
 #include "history/history_location_manager.h"
 #include "base/timer.h"
 
@@ -58,6 +59,8 @@ class CloudThemes;
 class Streaming;
 class MediaRotation;
 class Histories;
+class HistoryCache;
+class SearchIndex;
 class DocumentMedia;
 class PhotoMedia;
 class Stickers;
@@ -121,6 +124,12 @@ public:
 	[[nodiscard]] Histories &histories() const {
 		return *_histories;
 	}
+	[[nodiscard]] HistoryCache &historyCache() const {
+		return *_historyCache;
+	}
+	[[nodiscard]] SearchIndex &searchIndex() const {
+		return *_searchIndex;
+	}
 	[[nodiscard]] Stickers &stickers() const {
 		return *_stickers;
 	}
@@ -295,6 +304,7 @@ public:
 	void notifyHistoryUnloaded(not_null<const History*> history);
 	[[nodiscard]] rpl::producer<not_null<const History*>> historyUnloaded() const;
 	void notifyItemDataChange(not_null<HistoryItem*> item);
+	void notifyItemDataChangeDelayed(not_null<HistoryItem*> item);
 	[[nodiscard]] rpl::producer<not_null<HistoryItem*>> itemDataChanges() const;
 
 	[[nodiscard]] rpl::producer<not_null<const HistoryItem*>> itemRemoved() const;
@@ -405,6 +415,7 @@ public:
 		not_null<ChannelData*> group) const;
 
 	void registerMessage(not_null<HistoryItem*> item);
+	void reserveMessages(PeerId peerId, int count);
 	void unregisterMessage(not_null<HistoryItem*> item);
 
 	void registerMessageTTL(TimeId when, not_null<HistoryItem*> item);
@@ -680,6 +691,7 @@ public:
 	void notifyPollUpdateDelayed(not_null<PollData*> poll);
 	[[nodiscard]] bool hasPendingWebPageGamePollNotification() const;
 	void sendWebPageGamePollNotifications();
+	void sendItemDataChangesDelayed();
 	[[nodiscard]] rpl::producer<not_null<WebPageData*>> webPageUpdates() const;
 
 	void channelDifferenceTooLong(not_null<ChannelData*> channel);
@@ -764,8 +776,6 @@ public:
 	void clearLocalStorage();
 
 private:
-	using Messages = std::unordered_map<MsgId, not_null<HistoryItem*>>;
-
 	void suggestStartExport();
 
 	void setupMigrationViewer();
@@ -787,8 +797,6 @@ private:
 		Folder *requestFolder,
 		const MTPDdialogFolder &data);
 
-	const Messages *messagesList(PeerId peerId) const;
-	not_null<Messages*> messagesListForInsert(PeerId peerId);
 	not_null<HistoryItem*> registerMessage(
 		std::unique_ptr<HistoryItem> item);
 	HistoryItem *changeMessageId(PeerId peerId, MsgId wasId, MsgId nowId);
@@ -937,7 +945,7 @@ private:
 	Dialogs::IndexedList _contactsNoChatsList;
 
 	MsgId _localMessageIdCounter = StartClientMsgId;
-	std::unordered_map<PeerId, Messages> _messages;
+	MessagesIndex _messages;
 	std::map<
 		not_null<HistoryItem*>,
 		base::flat_set<not_null<HistoryItem*>>> _dependentMessages;
@@ -1053,6 +1061,9 @@ private:
 	base::flat_map<not_null<UserData*>, TimeId> _watchingForOffline;
 	base::Timer _watchForOfflineTimer;
 
+	base::flat_set<FullMsgId> _itemDataChangesDelayed;
+	base::Timer _itemDataChangesTimer;
+
 	base::flat_map<not_null<ChannelData*>, MTP::DcId> _channelStatsDcIds;
 
 	rpl::event_stream<WebViewResultSent> _webViewResultSent;
@@ -1068,7 +1079,9 @@ private:
 	const std::unique_ptr<SendActionManager> _sendActionManager;
 	const std::unique_ptr<Streaming> _streaming;
 	const std::unique_ptr<MediaRotation> _mediaRotation;
+	const std::unique_ptr<SearchIndex> _searchIndex;
 	const std::unique_ptr<Histories> _histories;
+	const std::unique_ptr<HistoryCache> _historyCache;
 	const std::unique_ptr<Stickers> _stickers;
 	const std::unique_ptr<Reactions> _reactions;
 	const std::unique_ptr<EmojiStatuses> _emojiStatuses;
@@ -187,11 +187,37 @@ bool SparseIdsSliceBuilder::applyUpdate(
 	auto skippedAfter = (update.range.till == ServerMaxMsgId)
 		? 0
 		: std::optional<int> {};
+	if (!needMergeMessages) {
+		mergeSliceData(
+			update.count,
+			base::flat_set<MsgId> {},
+			skippedBefore,
+			skippedAfter);
+		return true;
+	}
+	const auto &messages = *update.messages;
+	if (!_key
+		|| int(messages.size()) <= _limitBefore + _limitAfter + 1) {
+		mergeSliceData(update.count, messages, skippedBefore, skippedAfter);
+		return true;
+	}
+
+	// Ids further than the limits from the key are cut by sliceToLimits()
+	// anyway, so don't copy the whole (maybe huge) storage slice.
+	const auto around = ranges::lower_bound(messages, _key);
+	const auto from = around
+		- std::min(int(around - messages.begin()), _limitBefore);
+	const auto till = around
+		+ std::min(int(messages.end() - around), _limitAfter + 1);
+	if (skippedBefore) {
+		*skippedBefore += int(from - messages.begin());
+	}
+	if (skippedAfter) {
+		*skippedAfter += int(messages.end() - till);
+	}
 	mergeSliceData(
 		update.count,
-		needMergeMessages
-			? *update.messages
-			: base::flat_set<MsgId> {},
+		base::flat_set<MsgId>(from, till),
 		skippedBefore,
 		skippedAfter);
 	return true;
@@ -217,7 +217,7 @@ StoryPreload::LoadTask::LoadTask(
 	for (auto i = 0; i != parts; ++i) {
 		_parts.emplace(i * part, QByteArray());
 	}
-	addToQueue();
+	addToQueue(Storage::kDownloadPreloadPriority);
 }
 
 StoryPreload::LoadTask::~LoadTask() {
@@ -0,0 +1,49 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_string_pool.h"
+
+#include <unordered_set>
+
+namespace Data {
+namespace {
+
+constexpr auto kMaxInternedLength = 256;
+constexpr auto kMaxInternedCount = 16384;
+
+struct Hash {
+	size_t operator()(const QString &value) const {
+		return qHash(value);
+	}
+};
+
+[[nodiscard]] std::unordered_set<QString, Hash> &Pool() {
+	static auto result = std::unordered_set<QString, Hash>();
+	return result;
+}
+
+} // namespace
+
+QString InternString(const QString &value) {
+	if (value.isEmpty() || value.size() > kMaxInternedLength) {
+		return value;
+	}
+	auto &pool = Pool();
+	if (const auto i = pool.find(value); i != end(pool)) {
+		return *i;
+	} else if (pool.size() >= kMaxInternedCount) {
+		// Strings given out before stay valid, they just stop sharing.
+		pool.clear();
+	}
+	return *pool.emplace(value).first;
+}
+
+QString InternString(const MTPstring &value) {
+	return InternString(qs(value));
+}
+
+} // namespace Data
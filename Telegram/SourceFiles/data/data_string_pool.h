@@ -0,0 +1,18 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Data {
+
+// Returns a copy sharing the buffer with an equal string passed before,
+// for short strings repeated in many messages (author names, urls).
+// Main thread only.
+[[nodiscard]] QString InternString(const QString &value);
+[[nodiscard]] QString InternString(const MTPstring &value);
+
+} // namespace Data
@@ -266,7 +266,10 @@ void Entry::notifyUnreadStateChange(const UnreadState &wasState) {
 			return state.messages || state.marks || state.mentions;
 		};
 		if (isForFilters(wasState) != isForFilters(nowState)) {
-			owner().chatsFilters().refreshHistory(history);
+			using Flag = Data::ChatFilter::Flag;
+			owner().chatsFilters().refreshHistory(
+				history,
+				Flag::NoRead | Flag::NoMuted);
 		}
 	}
 	updateChatListEntryPostponed();
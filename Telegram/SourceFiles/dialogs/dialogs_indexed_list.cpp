@@ -33,6 +33,7 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 		}
 		result.letters.emplace(ch, j->second.addToEnd(key));
 	}
+	indexWords(key);
 	return result;
 }
 
@@ -49,6 +50,7 @@ Row *IndexedList::addByName(Key key) {
 		}
 		j->second.addByName(key);
 	}
+	indexWords(key);
 	return result;
 }
 
@@ -127,6 +129,9 @@ void IndexedList::adjustByName(
 	const auto mainRow = _list.adjustByName(key);
 	if (!mainRow) return;
 
+	unindexWords(key);
+	indexWords(key);
+
 	auto toRemove = oldLetters;
 	auto toAdd = base::flat_set<QChar>();
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
@@ -164,6 +169,9 @@ void IndexedList::adjustNames(
 	auto mainRow = _list.getRow(key);
 	if (!mainRow) return;
 
+	unindexWords(key);
+	indexWords(key);
+
 	auto toRemove = oldLetters;
 	auto toAdd = base::flat_set<QChar>();
 	for (const auto &ch : key.entry()->chatListFirstLetters()) {
@@ -196,6 +204,7 @@ void IndexedList::adjustNames(
 
 void IndexedList::remove(Key key, Row *replacedBy) {
 	if (_list.remove(key, replacedBy)) {
+		unindexWords(key);
 		for (const auto &ch : key.entry()->chatListFirstLetters()) {
 			if (const auto it = _index.find(ch); it != _index.cend()) {
 				it->second.remove(key, replacedBy);
@@ -207,55 +216,141 @@ void IndexedList::remove(Key key, Row *replacedBy) {
 void IndexedList::clear() {
 	_list.clear();
 	_index.clear();
+	_words.clear();
+	_wordsVersions.clear();
+	_wordsIndexed = false;
+}
+
+void IndexedList::ensureWordsIndex() const {
+	if (_wordsIndexed) {
+		return;
+	}
+	_wordsIndexed = true;
+	_words.clear();
+	_wordsVersions.clear();
+	for (const auto &row : _list) {
+		const auto key = row->key();
+		const auto entry = key.entry();
+		for (const auto &word : entry->chatListNameWords()) {
+			_words.emplace_back(word, key);
+		}
+		_wordsVersions.emplace(key, entry->chatListNameVersion());
+	}
+	ranges::sort(_words);
+}
+
+void IndexedList::refreshChangedWords() const {
+	auto changed = std::vector<Key>();
+	for (const auto &[key, version] : _wordsVersions) {
+		if (key.entry()->chatListNameVersion() != version) {
+			changed.push_back(key);
+		}
+	}
+	for (const auto &key : changed) {
+		unindexWords(key);
+		indexWords(key);
+	}
+}
+
+void IndexedList::indexWords(Key key) const {
+	if (!_wordsIndexed) {
+		return;
+	}
+	const auto entry = key.entry();
+	for (const auto &word : entry->chatListNameWords()) {
+		auto value = std::pair(word, key);
+		const auto where = ranges::upper_bound(_words, value);
+		_words.insert(where, std::move(value));
+	}
+	_wordsVersions[key] = entry->chatListNameVersion();
+}
+
+void IndexedList::unindexWords(Key key) const {
+	if (!_wordsIndexed) {
+		return;
+	}
+	_words.erase(
+		ranges::remove(_words, key, &WordsIndex::value_type::second),
+		end(_words));
+	_wordsVersions.remove(key);
+}
+
+auto IndexedList::wordsWithPrefix(const QString &prefix) const
+-> std::pair<WordsIndex::const_iterator, WordsIndex::const_iterator> {
+	const auto from = ranges::lower_bound(
+		_words,
+		prefix,
+		ranges::less(),
+		&WordsIndex::value_type::first);
+	const auto till = std::partition_point(from, end(_words), [&](
+			const WordsIndex::value_type &entry) {
+		return entry.first.startsWith(prefix);
+	});
+	return { from, till };
 }
 
 std::vector<not_null<Row*>> IndexedList::filtered(
 		const QStringList &words) const {
-	const auto minimal = [&]() -> const Dialogs::List* {
-		if (empty()) {
-			return nullptr;
+	auto result = std::vector<not_null<Row*>>();
+	if (empty()) {
+		return result;
+	}
+	ensureWordsIndex();
+	refreshChangedWords();
+
+	using Range = std::pair<
+		WordsIndex::const_iterator,
+		WordsIndex::const_iterator>;
+	auto found = std::vector<Range>();
+	found.reserve(words.size());
+	for (const auto &word : words) {
+		if (word.isEmpty()) {
+			continue;
 		}
-		auto result = (const Dialogs::List*)nullptr;
-		for (const auto &word : words) {
-			if (word.isEmpty()) {
-				continue;
-			}
-			const auto found = filtered(word[0]);
-			if (!found || found->empty()) {
-				return nullptr;
-			} else if (!result || result->size() > found->size()) {
-				result = found;
-			}
+		const auto range = wordsWithPrefix(word);
+		if (range.first == range.second) {
+			return result;
 		}
-		return result;
-	}();
-	auto result = std::vector<not_null<Row*>>();
-	if (!minimal || minimal->empty()) {
+		found.push_back(range);
+	}
+	if (found.empty()) {
 		return result;
 	}
-	result.reserve(minimal->size());
-	for (const auto &row : *minimal) {
-		const auto &nameWords = row->entry()->chatListNameWords();
-		const auto found = [&](const QString &word) {
-			for (const auto &name : nameWords) {
-				if (name.startsWith(word)) {
-					return true;
-				}
-			}
-			return false;
-		};
-		const auto allFound = [&] {
-			for (const auto &word : words) {
-				if (!found(word)) {
-					return false;
-				}
-			}
-			return true;
-		}();
-		if (allFound) {
+	ranges::sort(found, ranges::less(), [](const Range &range) {
+		return range.second - range.first;
+	});
+
+	const auto collect = [](const Range &range) {
+		auto keys = std::vector<Key>();
+		keys.reserve(range.second - range.first);
+		for (auto i = range.first; i != range.second; ++i) {
+			keys.push_back(i->second);
+		}
+		ranges::sort(keys);
+		keys.erase(ranges::unique(keys), end(keys));
+		return keys;
+	};
+	auto keys = collect(found.front());
+	for (auto i = begin(found) + 1; i != end(found); ++i) {
+		const auto other = collect(*i);
+		auto common = std::vector<Key>();
+		common.reserve(std::min(keys.size(), other.size()));
+		ranges::set_intersection(keys, other, std::back_inserter(common));
+		keys = std::move(common);
+		if (keys.empty()) {
+			return result;
+		}
+	}
+
+	result.reserve(keys.size());
+	for (const auto &key : keys) {
+		if (const auto row = _list.getRow(key)) {
 			result.push_back(row);
 		}
 	}
+	ranges::sort(result, ranges::less(), [](not_null<Row*> row) {
+		return row->index();
+	});
 	return result;
 }
 
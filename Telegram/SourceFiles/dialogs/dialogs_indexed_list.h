@@ -83,6 +83,8 @@ public:
 	[[nodiscard]] iterator findByY(int y) { return all().findByY(y); }
 
 private:
+	using WordsIndex = std::vector<std::pair<QString, Key>>;
+
 	void adjustByName(
 		Key key,
 		const base::flat_set<QChar> &oldChars);
@@ -91,11 +93,25 @@ private:
 		not_null<History*> history,
 		const base::flat_set<QChar> &oldChars);
 
+	void ensureWordsIndex() const;
+	void refreshChangedWords() const;
+	void indexWords(Key key) const;
+	void unindexWords(Key key) const;
+	[[nodiscard]] auto wordsWithPrefix(const QString &prefix) const
+	-> std::pair<WordsIndex::const_iterator, WordsIndex::const_iterator>;
+
 	SortMode _sortMode = SortMode();
 	FilterId _filterId = 0;
 	List _list, _empty;
 	base::flat_map<QChar, List> _index;
 
+	// Sorted (name word, key) pairs, built on the first words search.
+	// Entries renamed without a notification (like forum topics) are
+	// found by their chatListNameVersion() and indexed again on search.
+	mutable WordsIndex _words;
+	mutable base::flat_map<Key, int> _wordsVersions;
+	mutable bool _wordsIndexed = false;
+
 };
 
 } // namespace Dialogs
@@ -19,8 +19,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "core/application.h"
+#include "core/core_settings.h"
 #include "core/click_handler_types.h"
 #include "core/shortcuts.h"
+#include "core/tracing.h"
 #include "ui/widgets/buttons.h"
 #include "ui/widgets/popup_menu.h"
 #include "ui/widgets/scroll_area.h"
@@ -148,6 +150,7 @@ InnerWidget::InnerWidget(
 : RpWidget(parent)
 , _controller(controller)
 , _shownList(controller->session().data().chatsList()->indexed())
+, _lastSeenRefreshTimer([=] { update(); })
 , _st(&st::defaultDialogRow)
 , _pinnedShiftAnimation([=](crl::time now) {
 	return pinnedShiftAnimationCallback(now);
@@ -600,6 +603,7 @@ void InnerWidget::showSavedSublists() {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	TRACE_SCOPE("Dialogs::InnerWidget::paintEvent");
 	Painter p(this);
 
 	p.setInactive(
@@ -615,6 +619,9 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 	auto dialogsClip = r;
 	const auto ms = crl::now();
 	const auto childListShown = _childListShown.current();
+	const auto lastSeenShown
+		= Core::App().settings().fork().lastSeenInDialogs();
+	const auto lastSeenNow = lastSeenShown ? base::unixtime::now() : 0;
 	auto context = Ui::PaintContext{
 		.st = _st,
 		.topicJumpCache = _topicJumpCache.get(),
@@ -656,6 +663,11 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
 		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+		const auto peer = lastSeenShown ? key.peer() : nullptr;
+		if (const auto user = peer ? peer->asUser() : nullptr) {
+			scheduleLastSeenRefresh(
+				Data::OnlineChangeTimeout(user, lastSeenNow));
+		}
 	};
 	if (_state == WidgetState::Default) {
 		const auto collapsedSkip = collapsedRowsOffset();
@@ -3752,6 +3764,10 @@ void InnerWidget::setupOnlineStatusCheck() {
 			}
 			if (const auto history = session().data().historyLoaded(user)) {
 				updateRowCornerStatusShown(history);
+				if ((update.flags & Data::PeerUpdate::Flag::OnlineStatus)
+					&& Core::App().settings().fork().lastSeenInDialogs()) {
+					updateDialogRow({ history, FullMsgId() });
+				}
 			}
 		} else if (const auto group = peer->asMegagroup()) {
 			if (const auto history = session().data().historyLoaded(group)) {
@@ -3765,6 +3781,14 @@ void InnerWidget::setupOnlineStatusCheck() {
 	}, lifetime());
 }
 
+void InnerWidget::scheduleLastSeenRefresh(crl::time timeout) {
+	// One timer for all the painted rows, the soonest phrase change wins.
+	if (!_lastSeenRefreshTimer.isActive()
+		|| _lastSeenRefreshTimer.remainingTime() > timeout) {
+		_lastSeenRefreshTimer.callOnce(timeout);
+	}
+}
+
 void InnerWidget::repaintDialogRowCornerStatus(not_null<History*> history) {
 	const auto user = history->peer->isUser();
 	const auto size = user
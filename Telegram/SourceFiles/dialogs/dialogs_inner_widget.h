@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/userpic_view.h"
 #include "base/flags.h"
 #include "base/object_ptr.h"
+#include "base/timer.h"
 
 namespace style {
 struct DialogRow;
@@ -286,6 +287,7 @@ private:
 
 	int defaultRowTop(not_null<Row*> row) const;
 	void setupOnlineStatusCheck();
+	void scheduleLastSeenRefresh(crl::time timeout);
 	void jumpToTop();
 
 	void updateRowCornerStatusShown(not_null<History*> history);
@@ -421,6 +423,7 @@ private:
 	rpl::lifetime _openedForumLifetime;
 
 	std::vector<std::unique_ptr<CollapsedRow>> _collapsedRows;
+	base::Timer _lastSeenRefreshTimer;
 	not_null<const style::DialogRow*> _st;
 	mutable std::unique_ptr<Ui::TopicJumpCache> _topicJumpCache;
 	int _collapsedSelected = -1;
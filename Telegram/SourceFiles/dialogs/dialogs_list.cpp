@@ -62,19 +62,21 @@ not_null<Row*> List::addByName(Key key) {
 void List::adjustByName(not_null<Row*> row) {
 	Expects(row->index() >= 0 && row->index() < _rows.size());
 
+	// All rows except this one are sorted, so binary search its place.
 	const auto &key = row->entry()->chatListNameSortKey();
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return row->entry()->chatListNameSortKey().compare(key) >= 0;
+	const auto before = std::partition_point(i + 1, _rows.end(), [&](
+			Row *row) {
+		return row->entry()->chatListNameSortKey().compare(key) < 0;
 	});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else if (i != _rows.begin()) {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
+		const auto after = std::partition_point(_rows.begin(), i, [&](
+				Row *row) {
 			return row->entry()->chatListNameSortKey().compare(key) <= 0;
-		}).base();
+		});
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -84,19 +86,21 @@ void List::adjustByName(not_null<Row*> row) {
 void List::adjustByDate(not_null<Row*> row) {
 	Expects(_sortMode == SortMode::Date);
 
+	// All rows except this one are sorted, so binary search its place.
 	const auto key = row->sortKey(_filterId);
 	const auto index = row->index();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
+	const auto before = std::partition_point(i + 1, _rows.end(), [&](
+			Row *row) {
+		return (row->sortKey(_filterId) > key);
 	});
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
+		const auto after = std::partition_point(_rows.begin(), i, [&](
+				Row *row) {
 			return (row->sortKey(_filterId) >= key);
-		}).base();
+		});
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
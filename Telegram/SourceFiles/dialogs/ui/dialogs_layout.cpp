@@ -49,6 +49,30 @@ namespace Dialogs::Ui {
 namespace {
 
 const auto kPsaBadgePrefix = "cloud_lng_badge_psa_";
+constexpr auto kDateTextCacheTimeout = 60 * crl::time(1000);
+constexpr auto kDateTextCacheLimit = 512;
+
+// Formatting dates through QLocale on each paint of each row is visible
+// while scrolling the chats list, so keep them for a minute.
+[[nodiscard]] QString FormatDialogsDateCached(const QDateTime &date) {
+	struct Cached {
+		QString text;
+		crl::time when = 0;
+	};
+	static auto cache = base::flat_map<qint64, Cached>();
+
+	const auto now = crl::now();
+	const auto key = date.toSecsSinceEpoch();
+	const auto i = cache.find(key);
+	if (i != end(cache) && now - i->second.when < kDateTextCacheTimeout) {
+		return i->second.text;
+	} else if (i == end(cache) && int(cache.size()) >= kDateTextCacheLimit) {
+		cache.clear();
+	}
+	auto text = Ui::FormatDialogsDate(date);
+	cache[key] = Cached{ text, now };
+	return text;
+}
 
 [[nodiscard]] bool ShowUserBotIcon(not_null<UserData*> user) {
 	return user->isBot() && !user->isSupport() && !user->isRepliesChat();
@@ -428,7 +452,7 @@ void PaintRow(
 		|| (supportMode
 			&& entry->session().supportHelper().isOccupiedBySomeone(history))) {
 		if (!promoted) {
-			const auto dateString = Ui::FormatDialogsDate(date);
+			const auto dateString = FormatDialogsDateCached(date);
 			PaintRowTopRight(p, dateString, rectForName, context);
 		}
 
@@ -551,7 +575,7 @@ void PaintRow(
 		}
 	} else if (!item->isEmpty()) {
 		if ((thread || sublist) && !promoted) {
-			const auto dateString = Ui::FormatDialogsDate(date);
+			const auto dateString = FormatDialogsDateCached(date);
 			PaintRowTopRight(p, dateString, rectForName, context);
 		}
 
@@ -15,6 +15,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/bytes.h"
 #include "base/options.h"
 #include "base/random.h"
+
+#include <QtCore/QCryptographicHash>
+
 #include <set>
 #include <deque>
 
@@ -23,8 +26,7 @@ namespace {
 
 constexpr auto kUserpicsSliceLimit = 100;
 constexpr auto kFileChunkSize = 128 * 1024;
-constexpr auto kFileRequestsCount = 2;
-//constexpr auto kFileNextRequestDelay = crl::time(20);
+constexpr auto kFileRequestsCount = 4;
 constexpr auto kChatsSliceLimit = 100;
 constexpr auto kMessagesSliceLimit = 100;
 constexpr auto kTopPeerSliceLimit = 100;
@@ -99,10 +101,23 @@ public:
 	void save(const Location &location, const QString &relativePath);
 	std::optional<QString> find(const Location &location) const;
 
+	// Different documents with equal bytes share the first written file.
+	void saveContent(
+		int64 size,
+		const QByteArray &hash,
+		const QString &relativePath);
+	std::optional<QString> findContent(
+		int64 size,
+		const QByteArray &hash) const;
+
 private:
+	using ContentKey = std::pair<int64, QByteArray>;
+
 	int _limit = 0;
 	std::map<LocationKey, QString> _map;
 	std::deque<LocationKey> _list;
+	std::map<ContentKey, QString> _contentMap;
+	std::deque<ContentKey> _contentList;
 
 };
 
@@ -165,6 +180,7 @@ struct ApiWrap::FileProcess {
 
 	Output::File file;
 	QString relativePath;
+	QCryptographicHash hash{ QCryptographicHash::Sha1 };
 
 	Fn<bool(FileProgress)> progress;
 	FnMut<void(const QString &relativePath)> done;
@@ -178,9 +194,19 @@ struct ApiWrap::FileProcess {
 	struct Request {
 		int64 offset = 0;
 		QByteArray bytes;
+		mtpRequestId requestId = 0;
 	};
 	std::deque<Request> requests;
+
+	// File reference refresh or a single part request of unknown size.
 	mtpRequestId requestId = 0;
+
+	void partFinished(int64 offset) {
+		const auto i = ranges::find(requests, offset, &Request::offset);
+		if (i != end(requests)) {
+			i->requestId = 0;
+		}
+	}
 };
 
 struct ApiWrap::FileProgress {
@@ -338,6 +364,37 @@ std::optional<QString> ApiWrap::LoadedFileCache::find(
 	return std::nullopt;
 }
 
+void ApiWrap::LoadedFileCache::saveContent(
+		int64 size,
+		const QByteArray &hash,
+		const QString &relativePath) {
+	if (size <= 0) {
+		return;
+	}
+	auto key = ContentKey(size, hash);
+	if (!_contentMap.emplace(key, relativePath).second) {
+		return;
+	}
+	_contentList.push_back(std::move(key));
+	if (_contentList.size() > _limit) {
+		_contentMap.erase(_contentList.front());
+		_contentList.pop_front();
+	}
+}
+
+std::optional<QString> ApiWrap::LoadedFileCache::findContent(
+		int64 size,
+		const QByteArray &hash) const {
+	if (size <= 0) {
+		return std::nullopt;
+	}
+	const auto i = _contentMap.find(ContentKey(size, hash));
+	if (i != end(_contentMap)) {
+		return i->second;
+	}
+	return std::nullopt;
+}
+
 ApiWrap::FileProcess::FileProcess(const QString &path, Output::Stats *stats)
 : file(path, stats) {
 }
@@ -383,6 +440,8 @@ auto ApiWrap::fileRequest(const Data::FileLocation &location, int64 offset) {
 			MTP_int(kFileChunkSize))
 	)).fail([=](const MTP::Error &result) {
 		_fileProcess->requestId = 0;
+		_fileProcess->partFinished(offset);
+		cancelFileRequests();
 		if (result.type() == u"TAKEOUT_FILE_EMPTY"_q
 			&& _otherDataProcess != nullptr) {
 			filePartDone(
@@ -397,7 +456,14 @@ auto ApiWrap::fileRequest(const Data::FileLocation &location, int64 offset) {
 			filePartUnavailable();
 		} else if (result.code() == 400
 			&& result.type().startsWith(u"FILE_REFERENCE_"_q)) {
-			filePartRefreshReference(offset);
+			// Parts after the first missing one are requested again
+			// once the reference is refreshed.
+			auto &requests = _fileProcess->requests;
+			const auto from = requests.front().offset;
+			requests.clear();
+			requests.push_back({ from });
+			_fileProcess->offset = from + kFileChunkSize;
+			filePartRefreshReference(from);
 		} else {
 			error(std::move(result));
 		}
@@ -1276,8 +1342,10 @@ void ApiWrap::skipFile(uint64 randomId) {
 	}
 	LOG(("Export Info: File skipped."));
 	Assert(!_fileProcess->requests.empty());
-	Assert(_fileProcess->requestId != 0);
-	_mtp.request(base::take(_fileProcess->requestId)).cancel();
+	if (_fileProcess->requestId) {
+		_mtp.request(base::take(_fileProcess->requestId)).cancel();
+	}
+	cancelFileRequests();
 	base::take(_fileProcess)->done(QString());
 }
 
@@ -2096,7 +2164,7 @@ void ApiWrap::loadFile(
 
 	loadFilePart();
 
-	Ensures(_fileProcess->requestId != 0);
+	Ensures(!_fileProcess->requests.empty());
 }
 
 auto ApiWrap::prepareFileProcess(
@@ -2120,36 +2188,40 @@ auto ApiWrap::prepareFileProcess(
 }
 
 void ApiWrap::loadFilePart() {
-	if (!_fileProcess
-		|| _fileProcess->requestId
-		|| _fileProcess->requests.size() >= kFileRequestsCount
-		|| (_fileProcess->size > 0
-			&& _fileProcess->offset >= _fileProcess->size)) {
+	if (!_fileProcess || _fileProcess->requestId) {
 		return;
 	}
+	const auto more = [&] {
+		const auto &process = *_fileProcess;
+		if (process.requests.size() >= kFileRequestsCount) {
+			return false;
+		} else if (process.size > 0) {
+			return (process.offset < process.size);
+		}
+		// Without a known size we request parts until an empty one.
+		return process.requests.empty();
+	};
+	while (more()) {
+		const auto offset = _fileProcess->offset;
+		_fileProcess->requests.push_back({ offset });
+		_fileProcess->requests.back().requestId = fileRequest(
+			_fileProcess->location,
+			offset
+		).done([=](const MTPupload_File &result) {
+			_fileProcess->partFinished(offset);
+			filePartDone(offset, result);
+		}).send();
+		_fileProcess->offset += kFileChunkSize;
+	}
+}
 
-	const auto offset = _fileProcess->offset;
-	_fileProcess->requests.push_back({ offset });
-	_fileProcess->requestId = fileRequest(
-		_fileProcess->location,
-		_fileProcess->offset
-	).done([=](const MTPupload_File &result) {
-		_fileProcess->requestId = 0;
-		filePartDone(offset, result);
-	}).send();
-	_fileProcess->offset += kFileChunkSize;
+void ApiWrap::cancelFileRequests() {
+	Expects(_fileProcess != nullptr);
 
-	if (_fileProcess->size > 0
-		&& _fileProcess->requests.size() < kFileRequestsCount) {
-		// Only one request at a time supported right now.
-		//const auto runner = _runner;
-		//crl::on_main([=] {
-		//	QTimer::singleShot(kFileNextRequestDelay, [=] {
-		//		runner([=] {
-		//			loadFilePart();
-		//		});
-		//	});
-		//});
+	for (auto &request : _fileProcess->requests) {
+		if (request.requestId) {
+			_mtp.request(base::take(request.requestId)).cancel();
+		}
 	}
 }
 
@@ -2164,11 +2236,13 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 	const auto &data = result.c_upload_file();
 	if (data.vbytes().v.isEmpty()) {
 		if (_fileProcess->size > 0) {
+			cancelFileRequests();
 			error("Empty bytes received in file part.");
 			return;
 		}
 		const auto result = _fileProcess->file.writeBlock({});
 		if (!result) {
+			cancelFileRequests();
 			ioError(result);
 			return;
 		}
@@ -2187,9 +2261,11 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 		while (!requests.empty() && !requests.front().bytes.isEmpty()) {
 			const auto &bytes = requests.front().bytes;
 			if (const auto result = file.writeBlock(bytes); !result) {
+				cancelFileRequests();
 				ioError(result);
 				return;
 			}
+			_fileProcess->hash.addData(bytes);
 			requests.pop_front();
 		}
 
@@ -2208,8 +2284,16 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 	}
 
 	auto process = base::take(_fileProcess);
-	const auto relativePath = process->relativePath;
-	_fileCache->save(process->location, relativePath);
+	const auto size = process->file.size();
+	const auto hash = process->hash.result();
+	if (const auto existing = _fileCache->findContent(size, hash)) {
+		if (process->file.remove()) {
+			process->relativePath = *existing;
+		}
+	} else {
+		_fileCache->saveContent(size, hash, process->relativePath);
+	}
+	_fileCache->save(process->location, process->relativePath);
 	process->done(process->relativePath);
 }
 
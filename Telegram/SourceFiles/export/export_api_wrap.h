@@ -215,6 +215,7 @@ private:
 		Fn<bool(FileProgress)> progress,
 		FnMut<void(QString)> done);
 	void loadFilePart();
+	void cancelFileRequests();
 	void filePartDone(int64 offset, const MTPupload_File &result);
 	void filePartUnavailable();
 	void filePartRefreshReference(int64 offset);
@@ -38,6 +38,12 @@ Result File::writeBlock(const QByteArray &block) {
 	return result;
 }
 
+bool File::remove() {
+	_file.reset();
+	_offset = 0;
+	return !QFile::exists(_path) || QFile::remove(_path);
+}
+
 Result File::writeBlockAttempt(const QByteArray &block) {
 	if (_stats && !_inStats) {
 		_inStats = true;
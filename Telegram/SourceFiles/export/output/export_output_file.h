@@ -28,6 +28,9 @@ public:
 
 	[[nodiscard]] Result writeBlock(const QByteArray &block);
 
+	// Deletes the written file, returns false if it is still on disk.
+	bool remove();
+
 	[[nodiscard]] static QString PrepareRelativePath(
 		const QString &folder,
 		const QString &suggested);
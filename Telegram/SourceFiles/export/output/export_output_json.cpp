@@ -28,43 +28,52 @@ QByteArray SerializeString(const QByteArray &value) {
 	const auto begin = value.data();
 	const auto end = begin + size;
 
+	// Most strings have nothing to escape, so copy them in runs
+	// instead of appending them char by char.
 	auto result = QByteArray();
-	result.reserve(2 + size * 4);
+	result.reserve(2 + size + 16);
 	result.append('"');
+	auto from = begin;
+	const auto escape = [&](const char *p, const char *with, int length) {
+		result.append(from, int(p - from)).append(with, length);
+		from = p + 1;
+	};
 	for (auto p = begin; p != end; ++p) {
 		const auto ch = *p;
 		if (ch == '\n') {
-			result.append("\\n", 2);
+			escape(p, "\\n", 2);
 		} else if (ch == '\r') {
-			result.append("\\r", 2);
+			escape(p, "\\r", 2);
 		} else if (ch == '\t') {
-			result.append("\\t", 2);
+			escape(p, "\\t", 2);
 		} else if (ch == '"') {
-			result.append("\\\"", 2);
+			escape(p, "\\\"", 2);
 		} else if (ch == '\\') {
-			result.append("\\\\", 2);
+			escape(p, "\\\\", 2);
 		} else if (ch >= 0 && ch < 32) {
-			result.append("\\x", 2).append('0' + (ch >> 4));
 			const auto left = (ch & 0x0F);
-			if (left >= 10) {
-				result.append('A' + (left - 10));
-			} else {
-				result.append('0' + left);
-			}
+			const char code[] = {
+				'\\',
+				'x',
+				char('0' + (ch >> 4)),
+				char((left >= 10) ? ('A' + (left - 10)) : ('0' + left)),
+			};
+			escape(p, code, 4);
 		} else if (ch == char(0xE2)
 			&& (p + 2 < end)
-			&& *(p + 1) == char(0x80)) {
-			if (*(p + 2) == char(0xA8)) { // Line separator.
-				result.append("\\u2028", 6);
-			} else if (*(p + 2) == char(0xA9)) { // Paragraph separator.
-				result.append("\\u2029", 6);
-			} else {
-				result.append(ch);
-			}
-		} else {
-			result.append(ch);
+			&& *(p + 1) == char(0x80)
+			&& (*(p + 2) == char(0xA8) || *(p + 2) == char(0xA9))) {
+			escape(
+				p,
+				((*(p + 2) == char(0xA8))
+					? "\\u2028" // Line separator.
+					: "\\u2029"), // Paragraph separator.
+				6);
+			p += 2;
+			from = p + 1;
 		}
 	}
+	result.append(from, int(end - from));
 	result.append('"');
 	return result;
 }
@@ -105,6 +114,11 @@ QByteArray SerializeObject(
 
 	auto first = true;
 	auto result = QByteArray();
+	auto reserve = indent.size() + 3;
+	for (const auto &[key, value] : values) {
+		reserve += next.size() + key.size() + value.size() + 5;
+	}
+	result.reserve(reserve);
 	result.append('{');
 	for (const auto &[key, value] : values) {
 		if (value.isEmpty()) {
@@ -130,6 +144,11 @@ QByteArray SerializeArray(
 
 	auto first = true;
 	auto result = QByteArray();
+	auto reserve = indent.size() + 3;
+	for (const auto &value : values) {
+		reserve += next.size() + value.size() + 1;
+	}
+	result.reserve(reserve);
 	result.append('[');
 	for (const auto &value : values) {
 		if (first) {
@@ -71,7 +71,7 @@ namespace {
 constexpr auto kMaxChannelAdmins = 200;
 constexpr auto kScrollDateHideTimeout = 1000;
 constexpr auto kEventsFirstPage = 20;
-constexpr auto kEventsPerPage = 50;
+constexpr auto kEventsPerPage = 100; // Server limit for channels.getAdminLog.
 constexpr auto kClearUserpicsAfter = 50;
 
 } // namespace
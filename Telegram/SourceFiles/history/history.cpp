@@ -62,6 +62,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "payments/payments_checkout_process.h"
 #include "core/crash_reports.h"
 #include "core/application.h"
+#include "core/tracing.h"
 #include "base/unixtime.h"
 #include "base/qt/qt_common_adapters.h"
 #include "styles/style_dialogs.h"
@@ -70,6 +71,7 @@ namespace {
 
 constexpr auto kNewBlockEachMessage = 50;
 constexpr auto kSkipCloudDraftsFor = TimeId(2);
+constexpr auto kResizeDeferredBlocksLimit = 4;
 
 using UpdateFlag = Data::HistoryUpdate::Flag;
 
@@ -444,6 +446,8 @@ std::vector<not_null<HistoryItem*>> History::createItems(
 		const QVector<MTPMessage> &data) {
 	auto result = std::vector<not_null<HistoryItem*>>();
 	result.reserve(data.size());
+	_messages.reserve(_messages.size() + data.size());
+	owner().reserveMessages(peer->id, data.size());
 	const auto localFlags = MessageFlags();
 	const auto detachExistingItem = true;
 	for (auto i = data.cend(), e = data.cbegin(); i != e;) {
@@ -1341,6 +1345,7 @@ void History::addEdgesToSharedMedia() {
 }
 
 void History::addOlderSlice(const QVector<MTPMessage> &slice) {
+	TRACE_SCOPE("History::addOlderSlice");
 	if (slice.isEmpty()) {
 		_loadedAtTop = true;
 		checkLocalMessages();
@@ -1380,6 +1385,7 @@ void History::addCreatedOlderSlice(
 }
 
 void History::addNewerSlice(const QVector<MTPMessage> &slice) {
+	TRACE_SCOPE("History::addNewerSlice");
 	bool wasLoadedAtBottom = loadedAtBottom();
 
 	if (slice.isEmpty()) {
@@ -1835,7 +1841,9 @@ void History::setFakeUnreadWhileOpened(bool enabled) {
 	} else {
 		_flags &= ~Flag::FakeUnreadWhileOpened;
 	}
-	owner().chatsFilters().refreshHistory(this);
+	owner().chatsFilters().refreshHistory(
+		this,
+		Data::ChatFilter::Flag::NoRead);
 }
 
 [[nodiscard]] bool History::fakeUnreadWhileOpened() const {
@@ -1856,7 +1864,9 @@ void History::setMuted(bool muted) {
 	session().changes().peerUpdated(
 		peer,
 		Data::PeerUpdate::Flag::Notifications);
-	owner().chatsFilters().refreshHistory(this);
+	owner().chatsFilters().refreshHistory(
+		this,
+		Data::ChatFilter::Flag::NoMuted);
 	if (const auto forum = peer->forum()) {
 		owner().notifySettings().forumParentMuteUpdated(forum);
 	}
@@ -1944,7 +1954,10 @@ void History::setFolderPointer(Data::Folder *folder) {
 	if (wasInList) {
 		addToChatList(0, owner().chatsList(folder));
 
-		owner().chatsFilters().refreshHistory(this);
+		using Flag = Data::ChatFilter::Flag;
+		owner().chatsFilters().refreshHistory(
+			this,
+			Flag::NoArchived | Flag::NoMuted);
 		updateChatListEntry();
 
 		owner().chatsListChanged(was);
@@ -2986,24 +2999,52 @@ HistoryItem *History::lastEditableMessage() const {
 }
 
 void History::resizeToWidth(int newWidth) {
+	resizeBlocks(newWidth, 0, 0, -1);
+}
+
+bool History::resizeToWidthAround(int newWidth, int top, int bottom) {
+	return resizeBlocks(newWidth, top, bottom, kResizeDeferredBlocksLimit);
+}
+
+bool History::resizeBlocks(int newWidth, int top, int bottom, int limit) {
 	using Request = HistoryBlock::ResizeRequest;
 	const auto request = (_flags & Flag::PendingAllItemsResize)
 		? Request::ReinitAll
 		: (_width != newWidth)
 		? Request::ResizeAll
 		: Request::ResizePending;
-	if (request == Request::ResizePending && !hasPendingResizedItems()) {
-		return;
+	if (request == Request::ResizePending
+		&& !hasPendingResizedItems()
+		&& !(_flags & Flag::HasDeferredBlocksResize)) {
+		return false;
 	}
-	_flags &= ~(Flag::HasPendingResizedItems | Flag::PendingAllItemsResize);
+	_flags &= ~(Flag::HasPendingResizedItems
+		| Flag::PendingAllItemsResize
+		| Flag::HasDeferredBlocksResize);
 
+	// Only the blocks that were already laid out may keep old heights.
+	const auto canDefer = (limit >= 0) && (_width > 0);
 	_width = newWidth;
-	int y = 0;
+	auto left = limit;
+	auto y = 0;
 	for (const auto &block : blocks) {
+		const auto heavy = (request != Request::ResizePending)
+			|| block->resizeDeferred();
+		const auto visible = (y < bottom) && (y + block->height() > top);
 		block->setY(y);
-		y += block->resizeGetHeight(newWidth, request);
+		if (!heavy || visible || !canDefer || block->height() <= 0) {
+			y += block->resizeGetHeight(newWidth, request);
+		} else if (left > 0) {
+			--left;
+			y += block->resizeGetHeight(newWidth, request);
+		} else {
+			block->deferResize(request);
+			y += block->height();
+			_flags |= Flag::HasDeferredBlocksResize;
+		}
 	}
 	_height = y;
+	return (_flags & Flag::HasDeferredBlocksResize);
 }
 
 void History::forceFullResize() {
@@ -3413,6 +3454,37 @@ void History::clearUpTill(MsgId availableMinId) {
 	requestChatListMessage();
 }
 
+bool History::unloadBlocksBelow(int bottom) {
+	const auto canUnload = [&](not_null<HistoryBlock*> block) {
+		if (block->y() < bottom) {
+			return false;
+		}
+		for (const auto &view : block->messages) {
+			const auto item = view->data();
+			if (!item->isRegular() || item == _joinedMessage) {
+				return false;
+			}
+		}
+		return true;
+	};
+	auto unloaded = false;
+	while (blocks.size() > 1 && canUnload(blocks.back().get())) {
+		const auto block = blocks.back().get();
+
+		// The last remove() deletes the block.
+		for (auto i = int(block->messages.size()); i != 0; --i) {
+			block->remove(block->messages.back().get());
+		}
+		unloaded = true;
+	}
+	if (!unloaded) {
+		return false;
+	}
+	_loadedAtBottom = false;
+	setHasPendingResizedItems();
+	return true;
+}
+
 void History::applyGroupAdminChanges(const base::flat_set<UserId> &changes) {
 	for (const auto &block : blocks) {
 		for (const auto &message : block->messages) {
@@ -3508,6 +3580,9 @@ HistoryBlock::HistoryBlock(not_null<History*> history)
 }
 
 int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
+	if (_deferredResize) {
+		request = std::min(request, *base::take(_deferredResize));
+	}
 	auto y = 0;
 	if (request == ResizeRequest::ReinitAll) {
 		for (const auto &message : messages) {
@@ -3532,6 +3607,12 @@ int HistoryBlock::resizeGetHeight(int newWidth, ResizeRequest request) {
 	return _height;
 }
 
+void HistoryBlock::deferResize(ResizeRequest request) {
+	_deferredResize = _deferredResize
+		? std::min(request, *_deferredResize)
+		: request;
+}
+
 void HistoryBlock::remove(not_null<Element*> view) {
 	Expects(view->block() == this);
 
@@ -121,6 +121,11 @@ public:
 	void clear(ClearType type);
 	void clearUpTill(MsgId availableMinId);
 
+	// Destroys views of the whole blocks starting below the 'bottom'
+	// coordinate, the items stay loaded and get their views back when
+	// the history is loaded down again. Returns true if anything was unloaded.
+	bool unloadBlocksBelow(int bottom);
+
 	void applyGroupAdminChanges(const base::flat_set<UserId> &changes);
 
 	template <typename ...Args>
@@ -273,6 +278,11 @@ public:
 	HistoryItem *lastEditableMessage() const;
 
 	void resizeToWidth(int newWidth);
+
+	// Resizes the blocks intersecting [top, bottom) and a few more, other
+	// blocks keep their previous heights until the next calls.
+	// Returns true if some blocks still wait for the resize.
+	bool resizeToWidthAround(int newWidth, int top, int bottom);
 	void forceFullResize();
 	int height() const;
 
@@ -448,6 +458,7 @@ private:
 		FakeUnreadWhileOpened = (1 << 4),
 		HasPinnedMessages = (1 << 5),
 		ResolveChatListMessage = (1 << 6),
+		HasDeferredBlocksResize = (1 << 7),
 	};
 	using Flags = base::flags<Flag>;
 	friend inline constexpr auto is_flag_type(Flag) {
@@ -456,6 +467,8 @@ private:
 
 	void cacheTopPromoted(bool promoted);
 
+	bool resizeBlocks(int newWidth, int top, int bottom, int limit);
+
 	// when this item is destroyed scrollTopItem just points to the next one
 	// and scrollTopOffset remains the same
 	// if we are at the bottom of the window scrollTopItem == nullptr and
@@ -643,6 +656,13 @@ public:
 	void refreshView(not_null<Element*> view);
 
 	int resizeGetHeight(int newWidth, ResizeRequest request);
+
+	// Keeps the current height, the request is applied in the next resize.
+	void deferResize(ResizeRequest request);
+	[[nodiscard]] bool resizeDeferred() const {
+		return _deferredResize.has_value();
+	}
+
 	int y() const {
 		return _y;
 	}
@@ -687,5 +707,6 @@ protected:
 	int _y = 0;
 	int _height = 0;
 	int _indexInHistory = -1;
+	std::optional<ResizeRequest> _deferredResize;
 
 };
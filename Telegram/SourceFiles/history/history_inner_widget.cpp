@@ -350,7 +350,7 @@ HistoryInner::HistoryInner(
 		[=](QRect updated) { update(updated); },
 		controller->cachedReactionIconFactory().createMethod()))
 , _touchSelectTimer([=] { onTouchSelect(); })
-, _touchScrollTimer([=] { onTouchScrollTimer(); })
+, _touchScrollAnimation([=] { touchScrollStep(); })
 , _scrollDateCheck([this] { scrollDateCheck(); })
 , _scrollDateHideTimer([this] { scrollDateHideByTimer(); }) {
 	_history->delegateMixin()->setCurrent(this);
@@ -595,6 +595,14 @@ void HistoryInner::messagesReceivedDown(
 	}
 }
 
+bool HistoryInner::unloadMessagesBelow(int bottom) {
+	const auto htop = historyTop();
+	if (htop < 0 || hasPendingResizedItems()) {
+		return false;
+	}
+	return _history->unloadBlocksBelow(bottom - htop);
+}
+
 void HistoryInner::repaintItem(const HistoryItem *item) {
 	if (const auto view = viewByItem(item)) {
 		repaintItem(view);
@@ -608,7 +616,13 @@ void HistoryInner::repaintItem(const Element *view) {
 	const auto top = itemTop(view);
 	if (top >= 0) {
 		const auto range = view->verticalRepaintRange();
-		update(0, top + range.top, width(), range.height);
+		const auto from = std::max(top + range.top, _visibleAreaTop);
+		const auto till = std::min(
+			top + range.top + range.height,
+			_visibleAreaBottom);
+		if (from < till) {
+			update(0, from, width(), till - from);
+		}
 		const auto id = view->data()->fullId();
 		if (const auto area = _reactionsManager->lookupEffectArea(id)) {
 			update(*area);
@@ -1278,7 +1292,7 @@ HistoryInner::VideoUserpic *HistoryInner::validateVideoUserpic(
 	)).first->second.get();
 }
 
-void HistoryInner::onTouchScrollTimer() {
+void HistoryInner::touchScrollStep() {
 	auto nowTime = crl::now();
 	if (_touchScrollState == Ui::TouchScrollState::Acceleration && _touchWaitingAcceleration && (nowTime - _touchAccelerationTime) > 40) {
 		_touchScrollState = Ui::TouchScrollState::Manual;
@@ -1297,7 +1311,7 @@ void HistoryInner::onTouchScrollTimer() {
 			_touchScrollState = Ui::TouchScrollState::Manual;
 			_touchScroll = false;
 			_horizontalScrollLocked = false;
-			_touchScrollTimer.cancel();
+			_touchScrollAnimation.stop();
 		} else {
 			_touchTime = nowTime;
 		}
@@ -1451,7 +1465,7 @@ void HistoryInner::touchEvent(QTouchEvent *e) {
 			if (_touchScrollState == Ui::TouchScrollState::Manual) {
 				_touchScrollState = Ui::TouchScrollState::Auto;
 				_touchPrevPosValid = false;
-				_touchScrollTimer.callEach(15);
+				_touchScrollAnimation.start();
 				_touchTime = crl::now();
 			} else if (_touchScrollState == Ui::TouchScrollState::Auto) {
 				_touchScrollState = Ui::TouchScrollState::Manual;
@@ -3159,9 +3173,23 @@ void HistoryInner::recountHistoryGeometry() {
 
 	updateBotInfo(false);
 
-	_history->resizeToWidth(_contentWidth);
-	if (_migrated) {
-		_migrated->resizeToWidth(_contentWidth);
+	// Lay out the visible part first, the off-screen blocks are finished
+	// in the following passes, the scroll stays anchored to scrollTopItem.
+	const auto resize = [&](not_null<History*> history, int top) {
+		if (top < 0) {
+			history->resizeToWidth(_contentWidth);
+			return false;
+		}
+		return history->resizeToWidthAround(
+			_contentWidth,
+			_visibleAreaTop - visibleHeight - top,
+			_visibleAreaBottom + visibleHeight - top);
+	};
+	const auto htop = historyTop();
+	const auto mtop = migratedTop();
+	_hasDeferredResize = resize(_history, htop);
+	if (_migrated && resize(_migrated, mtop)) {
+		_hasDeferredResize = true;
 	}
 
 	// With migrated history we perhaps do not need to display
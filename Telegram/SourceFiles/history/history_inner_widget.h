@@ -111,6 +111,7 @@ public:
 	void messagesReceivedDown(
 		not_null<PeerData*> peer,
 		const QVector<MTPMessage> &messages);
+	bool unloadMessagesBelow(int bottom);
 
 	[[nodiscard]] TextForMimeData getSelectedText() const;
 
@@ -120,6 +121,9 @@ public:
 	void changeItemsRevealHeight(int revealHeight);
 	void checkActivation();
 	void recountHistoryGeometry();
+	[[nodiscard]] bool hasDeferredResize() const {
+		return _hasDeferredResize;
+	}
 	void updateSize();
 	void setShownPinned(HistoryItem *item);
 
@@ -236,7 +240,7 @@ protected:
 
 private:
 	void onTouchSelect();
-	void onTouchScrollTimer();
+	void touchScrollStep();
 
 	using ChosenReaction = HistoryView::Reactions::ChosenReaction;
 	using VideoUserpic = Dialogs::Ui::VideoUserpic;
@@ -443,6 +447,7 @@ private:
 	HistoryView::ElementDelegate *_migratedElementDelegate = nullptr;
 	int _contentWidth = 0;
 	int _historyPaddingTop = 0;
+	bool _hasDeferredResize = false;
 	int _revealHeight = 0;
 
 	// Save visible area coords for painting / pressing userpics.
@@ -521,7 +526,7 @@ private:
 	crl::time _touchSpeedTime = 0;
 	crl::time _touchAccelerationTime = 0;
 	crl::time _touchTime = 0;
-	base::Timer _touchScrollTimer;
+	Ui::Animations::Basic _touchScrollAnimation;
 
 	// _menu must be destroyed before _whoReactedMenuLifetime.
 	rpl::lifetime _whoReactedMenuLifetime;
@@ -48,6 +48,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_saved_sublist.h"
 #include "data/data_changes.h"
 #include "data/data_session.h"
+#include "data/data_search_index.h"
+#include "data/data_string_pool.h"
 #include "data/data_message_reactions.h"
 #include "data/data_folder.h"
 #include "data/data_forum.h"
@@ -126,6 +128,98 @@ template <typename T>
 	return false;
 }
 
+class ItemsPool final {
+public:
+	ItemsPool() = default;
+	ItemsPool(const ItemsPool &other) = delete;
+	ItemsPool &operator=(const ItemsPool &other) = delete;
+
+	[[nodiscard]] void *allocate();
+	void free(void *pointer);
+
+private:
+	static constexpr auto kSlabSize = 128;
+
+	union Chunk {
+		Chunk *next;
+		alignas(HistoryItem) std::byte storage[sizeof(HistoryItem)];
+	};
+	struct Slab {
+		std::array<Chunk, kSlabSize> chunks;
+		Chunk *free = nullptr;
+		int used = 0;
+		int initialized = 0;
+	};
+
+	[[nodiscard]] Slab *createSlab();
+	[[nodiscard]] Slab *findSlab(const void *pointer) const;
+	void destroySlab(Slab *slab);
+
+	base::flat_map<const Chunk*, std::unique_ptr<Slab>> _slabs;
+	std::vector<Slab*> _available;
+
+};
+
+void *ItemsPool::allocate() {
+	const auto slab = _available.empty() ? createSlab() : _available.back();
+	auto result = (Chunk*)nullptr;
+	if (slab->free) {
+		result = slab->free;
+		slab->free = result->next;
+	} else {
+		Assert(slab->initialized < kSlabSize);
+		result = &slab->chunks[slab->initialized++];
+	}
+	if (++slab->used == kSlabSize) {
+		_available.pop_back();
+	}
+	return result->storage;
+}
+
+void ItemsPool::free(void *pointer) {
+	const auto slab = findSlab(pointer);
+	Assert(slab != nullptr);
+
+	const auto chunk = static_cast<Chunk*>(pointer);
+	chunk->next = slab->free;
+	slab->free = chunk;
+	if (slab->used-- == kSlabSize) {
+		_available.push_back(slab);
+	} else if (!slab->used && _available.size() > 1) {
+		destroySlab(slab);
+	}
+}
+
+ItemsPool::Slab *ItemsPool::createSlab() {
+	auto slab = std::make_unique<Slab>();
+	const auto result = slab.get();
+	_slabs.emplace(result->chunks.data(), std::move(slab));
+	_available.push_back(result);
+	return result;
+}
+
+ItemsPool::Slab *ItemsPool::findSlab(const void *pointer) const {
+	const auto chunk = static_cast<const Chunk*>(pointer);
+	auto i = _slabs.upper_bound(chunk);
+	if (i == begin(_slabs)) {
+		return nullptr;
+	}
+	--i;
+	const auto slab = i->second.get();
+	return (chunk < slab->chunks.data() + kSlabSize) ? slab : nullptr;
+}
+
+void ItemsPool::destroySlab(Slab *slab) {
+	_available.erase(ranges::remove(_available, slab), end(_available));
+	_slabs.remove(slab->chunks.data());
+}
+
+[[nodiscard]] ItemsPool &Items() {
+	// Never destroyed, items may outlive static destructors order.
+	static const auto result = new ItemsPool();
+	return *result;
+}
+
 [[nodiscard]] HistoryItemCommonFields ForwardedFields(
 		HistoryItemCommonFields fields,
 		not_null<History*> history,
@@ -136,6 +230,18 @@ template <typename T>
 
 } // namespace
 
+void *HistoryItem::operator new(std::size_t size) {
+	Expects(size == sizeof(HistoryItem));
+
+	return Items().allocate();
+}
+
+void HistoryItem::operator delete(void *pointer) {
+	if (pointer) {
+		Items().free(pointer);
+	}
+}
+
 void HistoryItem::HistoryItem::Destroyer::operator()(HistoryItem *value) {
 	if (value) {
 		value->destroy();
@@ -185,8 +291,10 @@ void HistoryItem::FillForwardedInfo(
 	if (const auto fromId = data.vfrom_id()) {
 		config.originalSenderId = peerFromMTP(*fromId);
 	}
-	config.originalSenderName = qs(data.vfrom_name().value_or_empty());
-	config.originalPostAuthor = qs(data.vpost_author().value_or_empty());
+	config.originalSenderName = Data::InternString(
+		data.vfrom_name().value_or_empty());
+	config.originalPostAuthor = Data::InternString(
+		data.vpost_author().value_or_empty());
 	config.forwardPsaType = qs(data.vpsa_type().value_or_empty());
 	const auto savedFromPeer = data.vsaved_from_peer();
 	const auto savedFromMsgId = data.vsaved_from_msg_id();
@@ -3072,6 +3180,7 @@ void HistoryItem::setTextValue(TextWithEntities text, bool force) {
 	if (had || force) {
 		history()->owner().requestItemTextRefresh(this);
 	}
+	history()->owner().searchIndex().refresh(this);
 }
 
 bool HistoryItem::inHighlightProcess() const {
@@ -3586,7 +3695,7 @@ void HistoryItem::updateReactions(const MTPMessageReactions *reactions) {
 		markReactionsRead();
 	}
 	CheckReactionNotificationSchedule(this, wasRecentUsers);
-	_history->owner().notifyItemDataChange(this);
+	_history->owner().notifyItemDataChangeDelayed(this);
 }
 
 bool HistoryItem::changeReactions(const MTPMessageReactions *reactions) {
@@ -3669,7 +3778,8 @@ void HistoryItem::createComponents(const MTPDmessage &data) {
 		: HistoryMessageRepliesData(data.vreplies());
 	config.markup = HistoryMessageMarkupData(data.vreply_markup());
 	config.editDate = data.vedit_date().value_or_empty();
-	config.postAuthor = qs(data.vpost_author().value_or_empty());
+	config.postAuthor = Data::InternString(
+		data.vpost_author().value_or_empty());
 	createComponents(std::move(config));
 }
 
@@ -167,6 +167,11 @@ public:
 		not_null<GameData*> game);
 	~HistoryItem();
 
+	// Items are allocated in slabs, so that big history slices
+	// don't scatter them all over the heap. Main thread only.
+	[[nodiscard]] static void *operator new(std::size_t size);
+	static void operator delete(void *pointer);
+
 	struct Destroyer {
 		void operator()(HistoryItem *value);
 	};
@@ -39,6 +39,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_channel.h"
 #include "data/data_media_types.h"
 #include "data/data_session.h"
+#include "data/data_string_pool.h"
 #include "data/data_user.h"
 #include "data/data_file_origin.h"
 #include "data/data_document.h"
@@ -317,13 +318,13 @@ ReplyFields ReplyFieldsFromMTP(
 		}
 		if (const auto header = data.vreply_from()) {
 			const auto &data = header->data();
-			result.externalPostAuthor
-				= qs(data.vpost_author().value_or_empty());
+			result.externalPostAuthor = Data::InternString(
+				data.vpost_author().value_or_empty());
 			result.externalSenderId = data.vfrom_id()
 				? peerFromMTP(*data.vfrom_id())
 				: PeerId();
-			result.externalSenderName
-				= qs(data.vfrom_name().value_or_empty());
+			result.externalSenderName = Data::InternString(
+				data.vfrom_name().value_or_empty());
 		}
 		if (const auto media = data.vreply_media()) {
 			result.externalMedia = HistoryItem::CreateMedia(item, *media);
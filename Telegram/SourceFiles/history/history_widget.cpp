@@ -73,6 +73,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_chat_filters.h"
 #include "data/data_file_origin.h"
 #include "data/data_histories.h"
+#include "data/data_history_cache.h"
 #include "data/data_group_call.h"
 #include "data/data_peer_values.h" // Data::AmPremiumValue.
 #include "data/data_premium_limits.h" // Data::PremiumLimits.
@@ -182,7 +183,11 @@ namespace {
 
 constexpr auto kMessagesPerPageFirst = 30;
 constexpr auto kMessagesPerPage = 50;
+constexpr auto kMessagesPerPageFast = 100; // server limit for getHistory
 constexpr auto kPreloadHeightsCount = 3; // when 3 screens to scroll left make a preload request
+constexpr auto kUnloadHeightsCount = 12; // when 12 screens are below unload views down to keep 6
+constexpr auto kUnloadKeepHeightsCount = 6;
+constexpr auto kHistoryCacheRequestId = -2; // not a real request, reading from Data::HistoryCache
 constexpr auto kScrollToVoiceAfterScrolledMs = 1000;
 constexpr auto kSkipRepaintWhileScrollMs = 100;
 constexpr auto kShowMembersDropdownTimeoutMs = 300;
@@ -237,6 +242,7 @@ HistoryWidget::HistoryWidget(
 	controller->chatStyle()->value(lifetime(), st::historyScroll),
 	false)
 , _updateHistoryItems([=] { updateHistoryItemsByTimer(); })
+, _resizeDeferredTimer([=] { updateHistoryGeometry(); })
 , _cornerButtons(
 	_scroll.data(),
 	controller->chatStyle(),
@@ -3566,12 +3572,38 @@ void HistoryWidget::firstLoadMessages() {
 		}
 	}
 
+	const auto fromEnd = (from == _history) && !offsetId && !offset;
+	if (fromEnd && Data::HistoryCache::Enabled()) {
+		const auto history = from;
+		_firstLoadRequest = kHistoryCacheRequestId;
+		session().data().historyCache().load(history, crl::guard(this, [=](
+				std::optional<MTPmessages_Messages> result) {
+			if (_firstLoadRequest != kHistoryCacheRequestId
+				|| _history != history) {
+				return;
+			} else if (result) {
+				messagesReceived(history->peer, *result, _firstLoadRequest);
+			} else {
+				_firstLoadRequest = 0;
+				sendFirstLoadRequest(history, offsetId, offset, loadCount);
+			}
+		}));
+		return;
+	}
+	sendFirstLoadRequest(from, offsetId, offset, loadCount);
+}
+
+void HistoryWidget::sendFirstLoadRequest(
+		not_null<History*> history,
+		MsgId offsetId,
+		int offset,
+		int loadCount) {
 	const auto offsetDate = 0;
 	const auto maxId = 0;
 	const auto minId = 0;
 	const auto historyHash = uint64(0);
 
-	const auto history = from;
+	const auto fromEnd = (history == _history) && !offsetId && !offset;
 	const auto type = Data::Histories::RequestType::History;
 	auto &histories = history->owner().histories();
 	_firstLoadRequest = histories.sendRequest(history, type, [=](Fn<void()> finish) {
@@ -3585,6 +3617,9 @@ void HistoryWidget::firstLoadMessages() {
 			MTP_int(minId),
 			MTP_long(historyHash)
 		)).done([=](const MTPmessages_Messages &result) {
+			if (fromEnd) {
+				history->owner().historyCache().save(history, result);
+			}
 			messagesReceived(history->peer, result, _firstLoadRequest);
 			finish();
 		}).fail([=](const MTP::Error &error) {
@@ -3594,6 +3629,15 @@ void HistoryWidget::firstLoadMessages() {
 	});
 }
 
+bool HistoryWidget::scrollOutrunsPreload(bool down) const {
+	// Less than a screen is left before the loaded edge, so the scroll
+	// gets there faster than kMessagesPerPage slices arrive.
+	const auto left = down
+		? (_scroll->scrollTopMax() - _scroll->scrollTop())
+		: _scroll->scrollTop();
+	return (left < _scroll->height());
+}
+
 void HistoryWidget::loadMessages() {
 	if (!_history || _preloadRequest) {
 		return;
@@ -3614,9 +3658,11 @@ void HistoryWidget::loadMessages() {
 
 	const auto offsetId = from->minMsgId();
 	const auto addOffset = 0;
-	const auto loadCount = offsetId
-		? kMessagesPerPage
-		: kMessagesPerPageFirst;
+	const auto loadCount = !offsetId
+		? kMessagesPerPageFirst
+		: scrollOutrunsPreload(false)
+		? kMessagesPerPageFast
+		: kMessagesPerPage;
 	const auto offsetDate = 0;
 	const auto maxId = 0;
 	const auto minId = 0;
@@ -3669,7 +3715,9 @@ void HistoryWidget::loadMessagesDown() {
 		return;
 	}
 
-	const auto loadCount = kMessagesPerPage;
+	const auto loadCount = scrollOutrunsPreload(true)
+		? kMessagesPerPageFast
+		: kMessagesPerPage;
 	auto addOffset = -loadCount;
 	auto offsetId = from->maxMsgId();
 	if (!offsetId) {
@@ -3869,6 +3917,15 @@ void HistoryWidget::preloadHistoryByScroll() {
 	auto scrollHeight = _scroll->height();
 	if (scrollTop + kPreloadHeightsCount * scrollHeight >= scrollTopMax) {
 		loadMessagesDown();
+	} else if (!_preloadDownRequest
+		&& scrollTop + kUnloadHeightsCount * scrollHeight < scrollTopMax) {
+		const auto keep = kUnloadKeepHeightsCount * scrollHeight;
+		if (_list->unloadMessagesBelow(scrollTop + scrollHeight + keep)) {
+			updateHistoryGeometry(
+				false,
+				false,
+				{ ScrollChangeNoJumpToBottom, 0 });
+		}
 	}
 	if (scrollTop <= kPreloadHeightsCount * scrollHeight) {
 		loadMessages();
@@ -6314,6 +6371,9 @@ void HistoryWidget::updateListSize() {
 	Expects(_list != nullptr);
 
 	_list->recountHistoryGeometry();
+	if (_list->hasDeferredResize()) {
+		_resizeDeferredTimer.callOnce(0);
+	}
 	auto washidden = _scroll->isHidden();
 	if (washidden) {
 		_scroll->show();
@@ -147,6 +147,11 @@ public:
 	void loadMessages();
 	void loadMessagesDown();
 	void firstLoadMessages();
+	void sendFirstLoadRequest(
+		not_null<History*> history,
+		MsgId offsetId,
+		int offset,
+		int loadCount);
 	void delayedShowAt(
 		MsgId showAtMsgId,
 		const TextWithEntities &highlightPart,
@@ -610,6 +615,7 @@ private:
 	int countInitialScrollTop();
 	int countAutomaticScrollTop();
 	void preloadHistoryByScroll();
+	[[nodiscard]] bool scrollOutrunsPreload(bool down) const;
 	void checkReplyReturns();
 	void scrollToAnimationCallback(FullMsgId attachToId, int relativeTo);
 
@@ -727,6 +733,7 @@ private:
 	int _lastScrollTop = 0; // gifs optimization
 	crl::time _lastScrolled = 0;
 	base::Timer _updateHistoryItems;
+	base::Timer _resizeDeferredTimer;
 
 	crl::time _lastUserScrolled = 0;
 	bool _synteticScrollEvent = false;
@@ -17,6 +17,29 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 
 namespace HistoryView::Controls {
+namespace {
+
+constexpr auto kFailedRetryTimeout = 60 * crl::time(1000);
+
+// Compose fields of all chats share the resolved previews of a session.
+[[nodiscard]] std::shared_ptr<WebpageResolver> SessionResolver(
+		not_null<Main::Session*> session) {
+	static auto Resolvers = base::flat_map<
+		not_null<Main::Session*>,
+		std::shared_ptr<WebpageResolver>>();
+	const auto i = Resolvers.find(session);
+	if (i != end(Resolvers)) {
+		return i->second;
+	}
+	auto result = std::make_shared<WebpageResolver>(session);
+	Resolvers.emplace(session, result);
+	session->lifetime().add([=] {
+		Resolvers.remove(session);
+	});
+	return result;
+}
+
+} // namespace
 
 WebPageText TitleAndDescriptionFromWebPage(not_null<WebPageData*> d) {
 	QString resultTitle, resultDescription;
@@ -118,16 +141,19 @@ WebpageResolver::WebpageResolver(not_null<Main::Session*> session)
 std::optional<WebPageData*> WebpageResolver::lookup(
 		const QString &link) const {
 	const auto i = _cache.find(link);
-	return (i == end(_cache))
-		? std::optional<WebPageData*>()
-		: (i->second && !i->second->failed)
-		? i->second
-		: nullptr;
+	if (i == end(_cache)) {
+		return std::nullopt;
+	} else if (i->second.page && !i->second.page->failed) {
+		return i->second.page;
+	} else if (i->second.failed + kFailedRetryTimeout < crl::now()) {
+		return std::nullopt;
+	}
+	return nullptr;
 }
 
 QString WebpageResolver::find(not_null<WebPageData*> page) const {
 	for (const auto &[link, cached] : _cache) {
-		if (cached == page) {
+		if (cached.page == page) {
 			return link;
 		}
 	}
@@ -135,7 +161,9 @@ QString WebpageResolver::find(not_null<WebPageData*> page) const {
 }
 
 void WebpageResolver::request(const QString &link, bool force) {
-	if (_requestLink == link && !force) {
+	auto &entry = _requests[link];
+	++entry.users;
+	if (entry.id && !force) {
 		return;
 	}
 	const auto done = [=](const MTPDmessageMediaWebPage &data) {
@@ -145,39 +173,47 @@ void WebpageResolver::request(const QString &link, bool force) {
 			page->pendingTill = 0;
 			page->failed = true;
 		}
-		_cache.emplace(link, page->failed ? nullptr : page.get());
+		_cache[link] = page->failed
+			? Cached{ .failed = crl::now() }
+			: Cached{ .page = page.get() };
 		_resolved.fire_copy(link);
 	};
 	const auto fail = [=] {
-		_cache.emplace(link, nullptr);
+		_cache[link] = Cached{ .failed = crl::now() };
 		_resolved.fire_copy(link);
 	};
-	_requestLink = link;
-	_requestId = _api.request(
+	const auto finish = [=](mtpRequestId requestId) {
+		const auto i = _requests.find(link);
+		if (i != end(_requests) && i->second.id == requestId) {
+			_requests.erase(i);
+		}
+	};
+	if (entry.id) {
+		_api.request(base::take(entry.id)).cancel();
+	}
+	entry.id = _api.request(
 		MTPmessages_GetWebPagePreview(
 			MTP_flags(0),
 			MTP_string(link),
 			MTPVector<MTPMessageEntity>()
 	)).done([=](const MTPMessageMedia &result, mtpRequestId requestId) {
-		if (_requestId == requestId) {
-			_requestId = 0;
-		}
+		finish(requestId);
 		result.match([=](const MTPDmessageMediaWebPage &data) {
 			done(data);
 		}, [&](const auto &d) {
 			fail();
 		});
 	}).fail([=](const MTP::Error &error, mtpRequestId requestId) {
-		if (_requestId == requestId) {
-			_requestId = 0;
-		}
+		finish(requestId);
 		fail();
 	}).send();
 }
 
 void WebpageResolver::cancel(const QString &link) {
-	if (_requestLink == link) {
-		_api.request(base::take(_requestId)).cancel();
+	const auto i = _requests.find(link);
+	if (i != end(_requests) && !--i->second.users) {
+		_api.request(i->second.id).cancel();
+		_requests.erase(i);
 	}
 }
 
@@ -185,13 +221,13 @@ WebpageProcessor::WebpageProcessor(
 	not_null<History*> history,
 	not_null<Ui::InputField*> field)
 : _history(history)
-, _resolver(std::make_shared<WebpageResolver>(&history->session()))
+, _resolver(SessionResolver(&history->session()))
 , _parser(field)
 , _timer([=] {
 	if (!ShowWebPagePreview(_data) || _link.isEmpty()) {
 		return;
 	}
-	_resolver->request(_link, true);
+	request(_link, true);
 }) {
 	_history->session().downloaderTaskFinished(
 	) | rpl::filter([=] {
@@ -216,6 +252,10 @@ WebpageProcessor::WebpageProcessor(
 	}, _lifetime);
 
 	_resolver->resolved() | rpl::start_with_next([=](QString link) {
+		if (_requested == link) {
+			// The request is finished, nothing to cancel anymore.
+			_requested = QString();
+		}
 		if (_link != link
 			|| _draft.removed
 			|| (_draft.manual && _draft.url != link)) {
@@ -233,6 +273,10 @@ WebpageProcessor::WebpageProcessor(
 	}, _lifetime);
 }
 
+WebpageProcessor::~WebpageProcessor() {
+	cancelRequest();
+}
+
 rpl::producer<> WebpageProcessor::repaintRequests() const {
 	return _repaintRequests.events();
 }
@@ -280,15 +324,30 @@ void WebpageProcessor::apply(Data::WebPageDraft draft, bool reparse) {
 			}
 			updateFromData();
 		} else {
-			_resolver->request(_link);
+			request(_link);
 			return;
 		}
 	} else if (!draft.manual && !_draft.manual) {
 		_draft = draft;
 		checkNow(reparse);
 	}
-	if (_link != was) {
-		_resolver->cancel(was);
+	if (_link != was && _requested == was) {
+		cancelRequest();
+	}
+}
+
+void WebpageProcessor::request(const QString &link, bool force) {
+	if (_requested == link && !force) {
+		return;
+	}
+	cancelRequest();
+	_requested = link;
+	_resolver->request(link, force);
+}
+
+void WebpageProcessor::cancelRequest() {
+	if (!_requested.isEmpty()) {
+		_resolver->cancel(base::take(_requested));
 	}
 }
 
@@ -377,10 +436,10 @@ void WebpageProcessor::checkPreview() {
 		}
 	}
 	if (_link != chosen) {
-		_resolver->cancel(_link);
+		cancelRequest();
 		_link = chosen;
 		if (!page && !_link.isEmpty()) {
-			_resolver->request(_link);
+			request(_link);
 		}
 	}
 	if (page) {
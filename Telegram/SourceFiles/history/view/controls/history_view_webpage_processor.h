@@ -66,13 +66,23 @@ public:
 	void cancel(const QString &link);
 
 private:
+	struct Cached {
+		WebPageData *page = nullptr;
+		crl::time failed = 0;
+	};
+	struct Request {
+		mtpRequestId id = 0;
+		int users = 0;
+	};
+
 	const not_null<Main::Session*> _session;
 	MTP::Sender _api;
-	base::flat_map<QString, WebPageData*> _cache;
+	base::flat_map<QString, Cached> _cache;
 	rpl::event_stream<QString> _resolved;
 
-	QString _requestLink;
-	mtpRequestId _requestId = 0;
+	// The resolver is shared, so each request is cancelled only
+	// when the last of the fields that requested the link drops it.
+	base::flat_map<QString, Request> _requests;
 
 };
 
@@ -81,6 +91,7 @@ public:
 	WebpageProcessor(
 		not_null<History*> history,
 		not_null<Ui::InputField*> field);
+	~WebpageProcessor();
 
 	void setDisabled(bool disabled);
 	void checkNow(bool force);
@@ -106,6 +117,8 @@ public:
 private:
 	void updateFromData();
 	void checkPreview();
+	void request(const QString &link, bool force = false);
+	void cancelRequest();
 
 	const not_null<History*> _history;
 	const std::shared_ptr<WebpageResolver> _resolver;
@@ -114,6 +127,7 @@ private:
 	QStringList _parsedLinks;
 	QStringList _links;
 	QString _link;
+	QString _requested;
 	WebPageData *_data = nullptr;
 	Data::WebPageDraft _draft;
 
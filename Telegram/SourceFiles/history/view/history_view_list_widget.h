@@ -430,7 +430,7 @@ private:
 	};
 
 	void onTouchSelect();
-	void onTouchScrollTimer();
+	void touchScrollStep();
 
 	void updateAroundPositionFromNearest(int nearestIndex);
 	void refreshRows(const Data::MessagesSlice &old);
@@ -757,7 +757,7 @@ private:
 	crl::time _touchSpeedTime = 0;
 	crl::time _touchAccelerationTime = 0;
 	crl::time _touchTime = 0;
-	base::Timer _touchScrollTimer;
+	Ui::Animations::Basic _touchScrollAnimation;
 
 	rpl::event_stream<FullMsgId> _requestedToEditMessage;
 	rpl::event_stream<FullReplyTo> _requestedToReplyToMessage;
@@ -1739,9 +1739,13 @@ void Message::paintText(
 		trect.setY(trect.y() + botTop->height);
 	}
 	auto highlightRequest = context.computeHighlightCache();
+
+	// Skip the lines outside of the repainted rect, long messages are
+	// often repainted only partially (scrolling, animated emoji nearby).
 	text().draw(p, {
 		.position = trect.topLeft(),
 		.availableWidth = trect.width(),
+		.clip = context.clip,
 		.palette = &stm->textPalette,
 		.pre = stm->preCache.get(),
 		.blockquote = context.quoteCache(contentColorIndex()),
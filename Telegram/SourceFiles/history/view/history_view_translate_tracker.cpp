@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "apiwrap.h"
 #include "api/api_text_entities.h"
+#include "api/api_translations.h"
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "data/data_changes.h"
@@ -148,7 +149,13 @@ bool TranslateTracker::add(
 void TranslateTracker::switchTranslation(
 		not_null<HistoryItem*> item,
 		LanguageId id) {
-	if (item->translationShowRequiresRequest(id)) {
+	if (!item->translationShowRequiresRequest(id)) {
+		return;
+	}
+	auto &translations = _history->session().api().translations();
+	if (const auto cached = translations.lookup(id, item->originalText())) {
+		item->translationDone(id, *cached);
+	} else {
 		_itemsToRequest.emplace(
 			item->fullId(),
 			ItemToRequest{ int(item->originalText().text.size()) });
@@ -296,6 +303,10 @@ void TranslateTracker::requestDone(
 				qs(data->vtext()),
 				Api::EntitiesFromMTP(session, data->ventities().v)
 			} : TextWithEntities();
+			session->api().translations().remember(
+				to,
+				item->originalText(),
+				text);
 			item->translationDone(to, std::move(text));
 		}
 		++index;
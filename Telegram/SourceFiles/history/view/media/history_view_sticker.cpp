@@ -31,6 +31,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document_media.h"
 #include "data/data_file_click_handler.h"
 #include "data/data_file_origin.h"
+#include "main/main_session.h"
 #include "chat_helpers/stickers_lottie.h"
 #include "styles/style_chat.h"
 
@@ -531,13 +532,27 @@ void Sticker::setupPlayer() {
 	Expects(_dataMedia != nullptr);
 
 	if (_data->sticker()->isLottie()) {
-		_player = std::make_unique<LottiePlayer>(
-			ChatHelpers::LottiePlayerFromDocument(
+		const auto box = countOptimalSize() * style::DevicePixelRatio();
+		const auto create = [&] {
+			return ChatHelpers::LottiePlayerFromDocument(
 				_dataMedia.get(),
 				_replacements,
 				_cachingTag,
-				countOptimalSize() * style::DevicePixelRatio(),
-				Lottie::Quality::High));
+				box,
+				Lottie::Quality::High);
+		};
+		if (sharedPlayerAllowed()) {
+			_player = LottiePlayer::Shared({
+				.sessionId = _data->session().uniqueId(),
+				.documentId = _data->id,
+				.replacements = _replacements,
+				.width = box.width(),
+				.height = box.height(),
+				.tag = int(_cachingTag),
+			}, create);
+		} else {
+			_player = std::make_unique<LottiePlayer>(create());
+		}
 	} else if (_data->sticker()->isWebm()) {
 		_player = std::make_unique<WebmPlayer>(
 			_dataMedia->owner()->location(),
@@ -549,6 +564,14 @@ void Sticker::setupPlayer() {
 	playerCreated();
 }
 
+bool Sticker::sharedPlayerAllowed() const {
+	// Views that play once or stop at a dice value need their own progress.
+	return (_diceIndex < 0)
+		&& !hasPremiumEffect()
+		&& (customEmojiPart() || !emojiSticker())
+		&& Core::App().settings().loopAnimatedStickers();
+}
+
 void Sticker::checkPremiumEffectStart() {
 	if (!_premiumEffectPlayed && hasPremiumEffect()) {
 		_premiumEffectPlayed = true;
@@ -114,6 +114,7 @@ private:
 
 	void setupPlayer();
 	void playerCreated();
+	[[nodiscard]] bool sharedPlayerAllowed() const;
 	void unloadPlayer();
 	void emojiStickerClicked();
 	void premiumStickerClicked();
@@ -20,6 +20,33 @@ LottiePlayer::LottiePlayer(std::unique_ptr<Lottie::SinglePlayer> lottie)
 : _lottie(std::move(lottie)) {
 }
 
+LottiePlayer::LottiePlayer(std::shared_ptr<Lottie::SinglePlayer> lottie)
+: _lottie(std::move(lottie)) {
+}
+
+std::unique_ptr<LottiePlayer> LottiePlayer::Shared(
+		SharedKey key,
+		FnMut<std::unique_ptr<Lottie::SinglePlayer>()> create) {
+	static auto Players = base::flat_map<
+		SharedKey,
+		std::weak_ptr<Lottie::SinglePlayer>>();
+
+	auto &weak = Players[key];
+	if (auto strong = weak.lock()) {
+		return std::make_unique<LottiePlayer>(std::move(strong));
+	}
+	for (auto i = begin(Players); i != end(Players);) {
+		if (i->second.expired() && i->first != key) {
+			i = Players.erase(i);
+		} else {
+			++i;
+		}
+	}
+	auto strong = std::shared_ptr<Lottie::SinglePlayer>(create());
+	Players[key] = strong;
+	return std::make_unique<LottiePlayer>(std::move(strong));
+}
+
 void LottiePlayer::setRepaintCallback(Fn<void()> callback) {
 	_repaintLifetime = _lottie->updates(
 	) | rpl::start_with_next([=](Lottie::Update update) {
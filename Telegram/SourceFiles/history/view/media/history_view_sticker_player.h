@@ -21,6 +21,25 @@ namespace HistoryView {
 class LottiePlayer final : public StickerPlayer {
 public:
 	explicit LottiePlayer(std::unique_ptr<Lottie::SinglePlayer> lottie);
+	explicit LottiePlayer(std::shared_ptr<Lottie::SinglePlayer> lottie);
+
+	struct SharedKey {
+		uint64 sessionId = 0;
+		uint64 documentId = 0;
+		const Lottie::ColorReplacements *replacements = nullptr;
+		int width = 0;
+		int height = 0;
+		int tag = 0;
+
+		friend inline auto operator<=>(
+			const SharedKey &,
+			const SharedKey &) = default;
+	};
+
+	// Looping views of the same sticker decode frames only once.
+	[[nodiscard]] static std::unique_ptr<LottiePlayer> Shared(
+		SharedKey key,
+		FnMut<std::unique_ptr<Lottie::SinglePlayer>()> create);
 
 	void setRepaintCallback(Fn<void()> callback) override;
 	bool ready() override;
@@ -34,7 +53,7 @@ public:
 	bool markFrameShown() override;
 
 private:
-	std::unique_ptr<Lottie::SinglePlayer> _lottie;
+	std::shared_ptr<Lottie::SinglePlayer> _lottie;
 	rpl::lifetime _repaintLifetime;
 
 };
@@ -802,11 +802,16 @@ void WebPage::draw(Painter &p, const PaintContext &context) const {
 		};
 		using namespace Data;
 		if (const auto thumbnail = _photoMedia->image(PhotoSize::Thumbnail)) {
-			pix = thumbnail->pixSingle(size, args);
-		} else if (const auto small = _photoMedia->image(PhotoSize::Small)) {
-			pix = small->pixSingle(size, args.blurred());
-		} else if (const auto blurred = _photoMedia->thumbnailInline()) {
-			pix = blurred->pixSingle(size, args.blurred());
+			pix = thumbnail->pixSingleAsync(size, args, crl::guard(this, [=] {
+				repaint();
+			}));
+		}
+		if (pix.isNull()) {
+			if (const auto small = _photoMedia->image(PhotoSize::Small)) {
+				pix = small->pixSingle(size, args.blurred());
+			} else if (const auto blurred = _photoMedia->thumbnailInline()) {
+				pix = blurred->pixSingle(size, args.blurred());
+			}
 		}
 		p.drawPixmapLeft(inner.left() + paintw - pw, tshift, width(), pix);
 		if (context.selected()) {
@@ -217,6 +217,22 @@ const ListSection::Items &ListSection::items() const {
 	return _items;
 }
 
+void ListSection::preloadItems(int top, int bottom) const {
+	if (!_mosaic.empty()) {
+		// Walk the same mosaic rows that paint() would for that area.
+		const auto preload = [](not_null<BaseLayout*> item, QPoint) {
+			item->preload();
+		};
+		_mosaic.paint(preload, QRect(0, top, QWIDGETSIZE_MAX, bottom - top));
+		return;
+	}
+	const auto fromIt = findItemAfterTop(top);
+	const auto tillIt = findItemAfterBottom(fromIt, bottom);
+	for (auto it = fromIt; it != tillIt; ++it) {
+		(*it)->preload();
+	}
+}
+
 void ListSection::paint(
 		Painter &p,
 		const ListContext &context,
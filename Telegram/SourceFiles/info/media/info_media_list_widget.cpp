@@ -638,11 +638,13 @@ auto ListWidget::foundItemInSection(
 void ListWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	const auto scrolledBy = visibleTop - _visibleTop;
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 
 	checkMoveToOtherViewer();
 	clearHeavyItems();
+	preloadItemsAhead(scrolledBy);
 
 	if (_dateBadge->goodType) {
 		updateDateBadgeFor(_visibleTop);
@@ -747,6 +749,27 @@ void ListWidget::clearHeavyItems() {
 	}
 }
 
+void ListWidget::preloadItemsAhead(int scrolledBy) {
+	const auto visibleHeight = _visibleBottom - _visibleTop;
+	if (!scrolledBy || visibleHeight <= 0) {
+		return;
+	}
+
+	// Heavy parts are kept for one screen around the visible area,
+	// so request thumbnails for that screen in the scroll direction.
+	const auto top = (scrolledBy > 0)
+		? _visibleBottom
+		: (_visibleTop - visibleHeight);
+	const auto bottom = top + visibleHeight;
+	const auto fromSectionIt = findSectionAfterTop(top);
+	const auto tillSectionIt = findSectionAfterBottom(
+		fromSectionIt,
+		bottom);
+	for (auto it = fromSectionIt; it != tillSectionIt; ++it) {
+		it->preloadItems(top - it->top(), bottom - it->top());
+	}
+}
+
 ListScrollTopState ListWidget::countScrollState() const {
 	if (_sections.empty() || _visibleTop <= 0) {
 		return {};
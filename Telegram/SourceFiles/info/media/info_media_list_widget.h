@@ -270,6 +270,7 @@ private:
 	void validateTrippleClickStartTime();
 	void checkMoveToOtherViewer();
 	void clearHeavyItems();
+	void preloadItemsAhead(int scrolledBy);
 
 	void setActionBoxWeak(QPointer<Ui::BoxContent> box);
 
@@ -430,6 +430,20 @@ void Inner::deleteUnusedInlineLayouts() {
 	}
 }
 
+bool Inner::deleteResultsLayouts(const Results &results) {
+	const auto shown = [&](const std::unique_ptr<Result> &result) {
+		const auto i = _inlineLayouts.find(result.get());
+		return (i != _inlineLayouts.cend()) && (i->second->position() >= 0);
+	};
+	if (ranges::any_of(results, shown)) {
+		return false;
+	}
+	for (const auto &result : results) {
+		_inlineLayouts.erase(result.get());
+	}
+	return true;
+}
+
 void Inner::preloadImages() {
 	_mosaic.forEach([](not_null<const ItemBase*> item) {
 		item->preload();
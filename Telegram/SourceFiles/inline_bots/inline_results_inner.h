@@ -58,6 +58,7 @@ struct CacheEntry {
 	QString switchPmStartToken;
 	QByteArray switchPmUrl;
 	Results results;
+	crl::time expires = 0;
 };
 
 class Inner
@@ -77,6 +78,9 @@ public:
 	void hideInlineRowsPanel();
 	void clearInlineRowsPanel();
 
+	// Returns false if some of the results are still shown.
+	[[nodiscard]] bool deleteResultsLayouts(const Results &results);
+
 	void preloadImages();
 
 	void inlineItemLayoutChanged(const ItemBase *layout) override;
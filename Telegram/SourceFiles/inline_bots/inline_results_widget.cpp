@@ -359,6 +359,7 @@ void Widget::inlineBotChanged() {
 	_inlineQuery = _inlineNextQuery = _inlineNextOffset = QString();
 	_inlineBot = nullptr;
 	_inlineCache.clear();
+	_inlineCacheExpired.clear();
 	_inner->inlineBotChanged();
 	_inner->hideInlineRowsPanel();
 
@@ -382,6 +383,8 @@ void Widget::inlineResultsDone(const MTPmessages_BotResults &result) {
 			it = _inlineCache.emplace(
 				_inlineQuery,
 				std::make_unique<CacheEntry>()).first;
+			it->second->expires = crl::now()
+				+ d.vcache_time().v * crl::time(1000);
 		}
 		auto entry = it->second.get();
 		entry->nextOffset = qs(d.vnext_offset().value_or_empty());
@@ -423,6 +426,13 @@ void Widget::inlineResultsDone(const MTPmessages_BotResults &result) {
 	onScroll();
 }
 
+void Widget::deleteUnusedExpiredResults() {
+	_inlineCacheExpired.erase(ranges::remove_if(_inlineCacheExpired, [&](
+			const std::unique_ptr<CacheEntry> &entry) {
+		return _inner->deleteResultsLayouts(entry->results);
+	}), end(_inlineCacheExpired));
+}
+
 void Widget::queryInlineBot(UserData *bot, PeerData *peer, QString query) {
 	bool force = false;
 	_inlineQueryPeer = peer;
@@ -438,6 +448,13 @@ void Widget::queryInlineBot(UserData *bot, PeerData *peer, QString query) {
 			_inlineRequestId = 0;
 			_requesting.fire(false);
 		}
+		const auto i = _inlineCache.find(query);
+		if (i != _inlineCache.cend() && i->second->expires <= crl::now()) {
+			// Shown layouts may still point to these results.
+			_inlineCacheExpired.push_back(std::move(i->second));
+			_inlineCache.erase(i);
+		}
+		deleteUnusedExpiredResults();
 		if (_inlineCache.find(query) != _inlineCache.cend()) {
 			_inlineRequestTimer.cancel();
 			_inlineQuery = _inlineNextQuery = query;
@@ -489,6 +506,7 @@ bool Widget::refreshInlineRows(int *added) {
 	}
 	if (!entry) prepareCache();
 	auto result = _inner->refreshInlineRows(_inlineQueryPeer, _inlineBot, entry, false);
+	deleteUnusedExpiredResults();
 	if (added) *added = result;
 	return (entry != nullptr);
 }
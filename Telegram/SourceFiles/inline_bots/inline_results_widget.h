@@ -118,6 +118,7 @@ private:
 	void updateContentHeight();
 
 	void inlineBotChanged();
+	void deleteUnusedExpiredResults();
 	int showInlineRows(bool newResults);
 	void recountContentMaxHeight();
 	bool refreshInlineRows(int *added = nullptr);
@@ -146,6 +147,7 @@ private:
 	Ui::CornersPixmaps _innerRounding;
 
 	std::map<QString, std::unique_ptr<CacheEntry>> _inlineCache;
+	std::vector<std::unique_ptr<CacheEntry>> _inlineCacheExpired;
 	base::Timer _inlineRequestTimer;
 
 	UserData *_inlineBot = nullptr;
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "iv/iv_prepare.h"
 #include "webview/webview_interface.h"
 
+#include <QtCore/QMutex>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QUrl>
 
@@ -20,6 +21,11 @@ bool FailureRecorded/* = false*/;
 
 } // namespace
 
+struct Data::PreparedCache {
+	QMutex mutex;
+	std::optional<Prepared> result;
+};
+
 QByteArray GeoPointId(Geo point) {
 	const auto lat = int(point.lat * 1000000);
 	const auto lon = int(point.lon * 1000000);
@@ -58,7 +64,8 @@ Data::Data(const MTPDwebPage &webpage, const MTPPage &page)
 	.name = (webpage.vsite_name()
 		? qs(*webpage.vsite_name())
 		: SiteNameFromUrl(qs(webpage.vurl())))
-})) {
+}))
+, _prepared(std::make_shared<PreparedCache>()) {
 }
 
 QString Data::id() const {
@@ -72,8 +79,30 @@ bool Data::partial() const {
 Data::~Data() = default;
 
 void Data::prepare(const Options &options, Fn<void(Prepared)> done) const {
-	crl::async([source = *_source, options, done = std::move(done)] {
-		done(Prepare(source, options));
+	// The source never changes, so the page is rendered only once.
+	auto cached = std::optional<Prepared>();
+	{
+		QMutexLocker lock(&_prepared->mutex);
+		cached = _prepared->result;
+	}
+	if (cached) {
+		crl::async([result = std::move(*cached), done = std::move(done)] {
+			done(result);
+		});
+		return;
+	}
+	crl::async([
+		source = *_source,
+		options,
+		cache = _prepared,
+		done = std::move(done)
+	] {
+		auto result = Prepare(source, options);
+		{
+			QMutexLocker lock(&cache->mutex);
+			cache->result = result;
+		}
+		done(std::move(result));
 	});
 }
 
@@ -48,7 +48,10 @@ public:
 	void prepare(const Options &options, Fn<void(Prepared)> done) const;
 
 private:
+	struct PreparedCache;
+
 	const std::unique_ptr<Source> _source;
+	const std::shared_ptr<PreparedCache> _prepared;
 
 };
 
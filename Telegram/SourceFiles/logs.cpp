@@ -12,8 +12,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "mtproto/facade.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 namespace {
 
+constexpr auto kFlushInterval = std::chrono::milliseconds(100);
+
 std::atomic<int> ThreadCounter/* = 0*/;
 thread_local bool WritingEntryFlag/* = false*/;
 
@@ -110,7 +116,7 @@ public:
 		return QString();
 	}
 
-	void write(LogDataType type, const QString &msg) {
+	void write(LogDataType type, const QByteArray &bytes) {
 		QMutexLocker lock(_logsMutex(type));
 		WritingEntryScope scope;
 
@@ -121,7 +127,7 @@ public:
 		if (!file || !file->isOpen()) {
 			return;
 		}
-		file->write(msg.toUtf8());
+		file->write(bytes);
 		file->flush();
 	}
 
@@ -253,6 +259,120 @@ NEW LOGGING INSTANCE STARTED!!!\n\
 
 LogsDataFields *LogsData = 0;
 
+// Debug, tcp and mtp entries are pushed to a lock-free list by the
+// writing threads and written to the files in batches by a background
+// thread, so that the network thread doesn't wait for the disk.
+// The thread runs only while the debug logs are enabled.
+class LogsDebugWriter final {
+public:
+	~LogsDebugWriter() {
+		stop();
+	}
+
+	void start() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_thread.joinable()) {
+			return;
+		}
+		_finishing = false;
+		_thread = std::thread([=] { run(); });
+		_running = true;
+	}
+
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_thread.joinable()) {
+				return;
+			}
+			_finishing = true;
+		}
+		_wake.notify_one();
+		_thread.join();
+
+		_running = false;
+		drain();
+	}
+
+	// Returns false if the entry should be written right away.
+	[[nodiscard]] bool push(LogDataType type, const QString &msg) {
+		if (!_running) {
+			return false;
+		}
+		const auto entry = new Entry{ type, msg };
+		entry->next = _head.load();
+		while (!_head.compare_exchange_weak(entry->next, entry)) {
+		}
+		if (!_running) {
+			// Raced with stop(), the final drain may have missed it.
+			drain();
+		}
+		return true;
+	}
+
+private:
+	struct Entry {
+		LogDataType type = LogDataDebug;
+		QString msg;
+		Entry *next = nullptr;
+	};
+
+	void run() {
+		auto lock = std::unique_lock<std::mutex>(_mutex);
+		while (!_finishing) {
+			_wake.wait_for(lock, kFlushInterval);
+			lock.unlock();
+			flush();
+			lock.lock();
+		}
+	}
+
+	void drain() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		flush();
+	}
+
+	void flush() {
+		if (!LogsData) {
+			return;
+		}
+		auto entry = _head.exchange(nullptr);
+		if (!entry) {
+			return;
+		}
+		auto ordered = (Entry*)nullptr;
+		while (entry) {
+			const auto next = entry->next;
+			entry->next = ordered;
+			ordered = entry;
+			entry = next;
+		}
+		QByteArray batches[LogDataCount];
+		while (ordered) {
+			const auto next = ordered->next;
+			batches[ordered->type] += ordered->msg.toUtf8();
+			delete ordered;
+			ordered = next;
+		}
+		for (auto i = 0; i != LogDataCount; ++i) {
+			if (!batches[i].isEmpty()) {
+				LogsData->write(LogDataType(i), batches[i]);
+			}
+		}
+	}
+
+	std::atomic<Entry*> _head = nullptr;
+	std::atomic<bool> _running = false;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	bool _finishing = false;
+	std::thread _thread;
+
+};
+
+// Never destroyed while logging, other threads may be pushing to it.
+LogsDebugWriter LogsWriter;
+
 using LogsInMemoryList = QList<QPair<LogDataType, QString>>;
 LogsInMemoryList *LogsInMemory = 0;
 LogsInMemoryList *DeletedLogsInMemory = SharedMemoryLocation<LogsInMemoryList, 0>();
@@ -261,8 +381,12 @@ QString LogsBeforeSingleInstanceChecked; // LogsInMemory already dumped in LogsD
 
 void _logsWrite(LogDataType type, const QString &msg) {
 	if (LogsData && (type == LogDataMain || LogsStartIndexChosen < 0)) {
-		if (type == LogDataMain || Logs::DebugEnabled()) {
-			LogsData->write(type, msg);
+		if (type == LogDataMain) {
+			LogsData->write(type, msg.toUtf8());
+		} else if (Logs::DebugEnabled()) {
+			if (!LogsWriter.push(type, msg)) {
+				LogsData->write(type, msg.toUtf8());
+			}
 		}
 	} else if (LogsInMemory != DeletedLogsInMemory) {
 		if (!LogsInMemory) {
@@ -332,6 +456,11 @@ bool DebugModeEnabled = false;
 
 void SetDebugEnabled(bool enabled) {
 	DebugModeEnabled = enabled;
+	if (!DebugEnabled()) {
+		LogsWriter.stop();
+	} else if (LogsData && LogsInMemory == DeletedLogsInMemory) {
+		LogsWriter.start();
+	}
 }
 
 bool DebugEnabled() {
@@ -424,6 +553,8 @@ void start() {
 }
 
 void finish() {
+	LogsWriter.stop();
+
 	delete LogsData;
 	LogsData = 0;
 
@@ -468,6 +599,10 @@ bool instanceChecked() {
 	}
 	LogsInMemory = DeletedLogsInMemory;
 
+	if (Logs::DebugEnabled()) {
+		LogsWriter.start();
+	}
+
 	DEBUG_LOG(("Debug logs started."));
 	LogsBeforeSingleInstanceChecked.clear();
 	return true;
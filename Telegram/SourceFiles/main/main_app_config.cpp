@@ -10,16 +10,21 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "apiwrap.h"
 #include "base/call_delayed.h"
 #include "main/main_account.h"
+#include "storage/storage_account.h"
 #include "ui/chat/chat_style.h"
 
 namespace Main {
 namespace {
 
 constexpr auto kRefreshTimeout = 3600 * crl::time(1000);
+constexpr auto kSerializeVersion = mtpPrime(1);
 
 } // namespace
 
 AppConfig::AppConfig(not_null<Account*> account) : _account(account) {
+	// Use the config from the last launch until the server answers.
+	applyLocal(_account->local().readAppConfig());
+
 	account->sessionChanges(
 	) | rpl::filter([=](Session *session) {
 		return (session != nullptr);
@@ -55,11 +60,9 @@ void AppConfig::refresh() {
 				LOG(("API Error: Unexpected config type."));
 				return;
 			}
-			_data.clear();
-			for (const auto &element : config.c_jsonObject().vvalue().v) {
-				element.match([&](const MTPDjsonObjectValue &data) {
-					_data.emplace_or_assign(qs(data.vkey()), data.vvalue());
-				});
+			applyData(config);
+			if (_account->sessionExists()) {
+				_account->local().writeAppConfig(serialize());
 			}
 			DEBUG_LOG(("getAppConfig result handled."));
 			_refreshed.fire({});
@@ -70,6 +73,58 @@ void AppConfig::refresh() {
 	}).send();
 }
 
+void AppConfig::applyData(const MTPJSONValue &config) {
+	Expects(config.type() == mtpc_jsonObject);
+
+	_data.clear();
+	for (const auto &element : config.c_jsonObject().vvalue().v) {
+		element.match([&](const MTPDjsonObjectValue &data) {
+			_data.emplace_or_assign(qs(data.vkey()), data.vvalue());
+		});
+	}
+}
+
+void AppConfig::applyLocal(const QByteArray &serialized) {
+	if (serialized.isEmpty() || (serialized.size() % sizeof(mtpPrime))) {
+		return;
+	}
+	auto buffer = mtpBuffer(serialized.size() / sizeof(mtpPrime));
+	memcpy(buffer.data(), serialized.constData(), serialized.size());
+	auto from = buffer.constData();
+	const auto end = from + buffer.size();
+	if (end - from < 2 || *from++ != kSerializeVersion) {
+		return;
+	}
+	const auto hash = *from++;
+	auto config = MTPJSONValue();
+	if (!config.read(from, end)
+		|| from != end
+		|| config.type() != mtpc_jsonObject) {
+		LOG(("App Config Error: Could not read local config."));
+		return;
+	}
+	_hash = hash;
+	applyData(config);
+}
+
+QByteArray AppConfig::serialize() const {
+	auto values = QVector<MTPJSONObjectValue>();
+	values.reserve(_data.size());
+	for (const auto &[key, value] : _data) {
+		values.push_back(MTP_jsonObjectValue(MTP_string(key), value));
+	}
+	const auto config = MTP_jsonObject(MTP_vector<MTPJSONObjectValue>(
+		std::move(values)));
+	auto buffer = mtpBuffer();
+	buffer.reserve(2 + config.innerLength() / sizeof(mtpPrime));
+	buffer.push_back(kSerializeVersion);
+	buffer.push_back(_hash);
+	config.write(buffer);
+	return QByteArray(
+		reinterpret_cast<const char*>(buffer.constData()),
+		buffer.size() * int(sizeof(mtpPrime)));
+}
+
 void AppConfig::refreshDelayed() {
 	base::call_delayed(kRefreshTimeout, _account, [=] {
 		refresh();
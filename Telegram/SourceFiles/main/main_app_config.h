@@ -60,6 +60,9 @@ public:
 
 private:
 	void refreshDelayed();
+	void applyData(const MTPJSONValue &config);
+	void applyLocal(const QByteArray &serialized);
+	[[nodiscard]] QByteArray serialize() const;
 
 	template <typename Extractor>
 	[[nodiscard]] auto getValue(
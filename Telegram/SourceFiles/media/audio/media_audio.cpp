@@ -88,6 +88,34 @@ void DestroyPlaybackDevice() {
 	}
 }
 
+// Thread: Any. Must be locked: AudioMutex.
+void LogPlaybackDeviceLatency() {
+	if (!alcIsExtensionPresent(AudioDevice, "ALC_SOFT_device_clock")) {
+		return;
+	}
+	using GetInteger64v = void(ALC_APIENTRY*)(
+		ALCdevice*,
+		ALCenum,
+		ALCsizei,
+		int64*);
+	const auto method = reinterpret_cast<GetInteger64v>(
+		alcGetProcAddress(AudioDevice, "alcGetInteger64vSOFT"));
+	if (!method) {
+		return;
+	}
+	auto latency = int64(0);
+	method(
+		AudioDevice,
+		alcGetEnumValue(AudioDevice, "ALC_DEVICE_LATENCY_SOFT"),
+		1,
+		&latency);
+	if (!ContextErrorHappened()) {
+		// The value is in nanoseconds.
+		LOG(("Audio Info: Playback device latency %1ms."
+			).arg(latency / 1000000));
+	}
+}
+
 // Thread: Any. Must be locked: AudioMutex.
 bool CreatePlaybackDevice() {
 	if (AudioDevice) return true;
@@ -121,6 +149,8 @@ bool CreatePlaybackDevice() {
 
 	alDistanceModel(AL_NONE);
 
+	LogPlaybackDeviceLatency();
+
 	return true;
 }
 
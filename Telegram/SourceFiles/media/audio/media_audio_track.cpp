@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/file_location.h"
+#include "base/options.h"
 
 #include <al.h>
 #include <alc.h>
@@ -22,8 +23,16 @@ namespace {
 
 constexpr auto kMaxFileSize = 10 * 1024 * 1024;
 constexpr auto kDetachDeviceTimeout = crl::time(500); // destroy the audio device after 500ms of silence
+constexpr auto kDetachDeviceLowLatencyTimeout = crl::time(60 * 1000);
 constexpr auto kTrackUpdateTimeout = crl::time(100);
 
+base::options::toggle OptionLowLatencyAudio({
+	.id = kOptionLowLatencyAudio,
+	.name = "Low latency audio playback",
+	.description = "Keep the audio output device open for a minute"
+		" after playback, so that the next sound starts without delay.",
+});
+
 ALuint CreateSource() {
 	auto source = ALuint(0);
 	alGenSources(1, &source);
@@ -42,6 +51,8 @@ ALuint CreateBuffer() {
 
 } // namespace
 
+const char kOptionLowLatencyAudio[] = "low-latency-audio";
+
 Track::Track(not_null<Instance*> instance) : _instance(instance) {
 	_instance->registerTrack(this);
 }
@@ -348,8 +359,13 @@ void Instance::scheduleDetachFromDevice() {
 }
 
 void Instance::scheduleDetachIfNotUsed() {
-	if (!_detachFromDeviceTimer.isActive()) {
+	if (_detachFromDeviceForce) {
+		// Don't wait for the low latency timeout on a forced detach.
 		_detachFromDeviceTimer.callOnce(kDetachDeviceTimeout);
+	} else if (!_detachFromDeviceTimer.isActive()) {
+		_detachFromDeviceTimer.callOnce(OptionLowLatencyAudio.value()
+			? kDetachDeviceLowLatencyTimeout
+			: kDetachDeviceTimeout);
 	}
 }
 
@@ -18,6 +18,8 @@ class FileLocation;
 namespace Media {
 namespace Audio {
 
+extern const char kOptionLowLatencyAudio[];
+
 class Instance;
 
 class Track {
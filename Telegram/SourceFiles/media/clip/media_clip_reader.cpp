@@ -36,6 +36,8 @@ namespace {
 constexpr auto kClipThreadsCount = 8;
 constexpr auto kAverageGifSize = 320 * 240;
 constexpr auto kWaitBeforeGifPause = crl::time(200);
+constexpr auto kMaxPausedDecoders = 4;
+constexpr auto kMaxPooledFrames = 8;
 
 QImage PrepareFrame(
 		const FrameRequest &request,
@@ -133,11 +135,17 @@ public:
 	void stop(Reader *reader);
 	bool carries(Reader *reader) const;
 
+	// Frame buffers of suspended and removed readers are reused.
+	[[nodiscard]] QImage takeFrameBuffer(QSize size);
+	void putFrameBuffer(QImage &&image);
+
 private:
 	void process();
 	void finish();
 	void callback(Reader *reader, Notification notification);
 	void clear();
+	void destroy(ReaderPrivate *reader);
+	void suspendPausedReaders();
 
 	QAtomicInt _loadLevel;
 	using ReaderPointers = QMap<Reader*, QAtomicInt>;
@@ -159,6 +167,8 @@ private:
 	using Readers = QMap<ReaderPrivate*, crl::time>;
 	Readers _readers;
 
+	std::deque<QImage> _framesPool;
+
 	QTimer _timer;
 	QThread *_processingInThread = nullptr;
 	bool _needReProcess = false;
@@ -465,8 +475,13 @@ Reader::~Reader() {
 
 class ReaderPrivate {
 public:
-	ReaderPrivate(Reader *reader, const Core::FileLocation &location, const QByteArray &data)
-	: _interface(reader)
+	ReaderPrivate(
+		not_null<Manager*> manager,
+		Reader *reader,
+		const Core::FileLocation &location,
+		const QByteArray &data)
+	: _manager(manager)
+	, _interface(reader)
 	, _data(data) {
 		if (_data.isEmpty()) {
 			_location = std::make_unique<Core::FileLocation>(location);
@@ -544,6 +559,9 @@ public:
 	}
 
 	ProcessResult finishProcess(crl::time ms) {
+		if (!_implementation && !resume(ms)) {
+			return error();
+		}
 		auto frameMs = _seekPositionMs + ms - _animationStarted;
 		auto readResult = _implementation->readFramesTill(frameMs, ms);
 		if (readResult == internal::ReaderImplementation::ReadResult::EndOfFile) {
@@ -570,6 +588,9 @@ public:
 	bool renderFrame() {
 		Expects(_request.valid());
 
+		if (frame()->original.isNull()) {
+			frame()->original = _manager->takeFrameBuffer(_request.frame);
+		}
 		if (!_implementation->renderFrame(frame()->original, frame()->alpha, frame()->index, _request.frame)) {
 			return false;
 		}
@@ -606,6 +627,24 @@ public:
 		_animationStarted = _nextFrameWhen = ms;
 	}
 
+	// Drop the decoder of an auto-paused reader, remembering the position
+	// of the last read frame, it will be started from there once shown.
+	// Reader writes its frames in turn, so it may show either of the two
+	// last written ones, only the oldest one is released here.
+	void suspend() {
+		Expects(_implementation != nullptr);
+
+		_implementation = nullptr;
+		_suspendedPositionMs = _nextFramePositionMs;
+		releaseFrame(_frames[(_frame + 1) % 3]);
+	}
+
+	void releaseFrames() {
+		for (auto &frame : _frames) {
+			releaseFrame(frame);
+		}
+	}
+
 	void pauseVideo(crl::time ms) {
 		if (_videoPausedAtMs) return; // Paused already.
 
@@ -622,6 +661,15 @@ public:
 		_videoPausedAtMs = 0;
 	}
 
+	bool resume(crl::time ms) {
+		_seekPositionMs = _suspendedPositionMs;
+		if (!init()) {
+			return false;
+		}
+		_animationStarted = ms;
+		return true;
+	}
+
 	ProcessResult error() {
 		stop();
 		_state = State::Error;
@@ -645,9 +693,11 @@ public:
 	}
 
 private:
+	const not_null<Manager*> _manager;
 	Reader *_interface;
 	State _state = State::Reading;
 	crl::time _seekPositionMs = 0;
+	crl::time _suspendedPositionMs = 0;
 
 	QByteArray _data;
 	std::unique_ptr<Core::FileLocation> _location;
@@ -674,6 +724,11 @@ private:
 	not_null<Frame*> frame() {
 		return _frames + _frame;
 	}
+	void releaseFrame(Frame &frame) {
+		frame.prepared = QImage();
+		_manager->putFrameBuffer(base::take(frame.original));
+		_manager->putFrameBuffer(base::take(frame.cache));
+	}
 
 	int _width = 0;
 	int _height = 0;
@@ -684,6 +739,7 @@ private:
 	crl::time _nextFramePositionMs = 0;
 
 	bool _autoPausedGif = false;
+	crl::time _autoPausedAt = 0;
 	bool _started = false;
 	crl::time _videoPausedAtMs = 0;
 
@@ -702,7 +758,7 @@ Manager::Manager(not_null<QThread*> thread) {
 }
 
 void Manager::append(Reader *reader, const Core::FileLocation &location, const QByteArray &data) {
-	reader->_private = new ReaderPrivate(reader, location, data);
+	reader->_private = new ReaderPrivate(this, reader, location, data);
 	_loadLevel.fetchAndAddRelaxed(kAverageGifSize);
 	update(reader);
 }
@@ -794,6 +850,7 @@ bool Manager::handleProcessResult(ReaderPrivate *reader, ProcessResult result, c
 		if (reader->_frames[ishowing].when > 0 && showing->displayed.loadAcquire() <= 0) { // current frame was not shown
 			if (reader->_frames[ishowing].when + kWaitBeforeGifPause < ms || (reader->_frames[iprevious].when && previous->displayed.loadAcquire() <= 0)) {
 				reader->_autoPausedGif = true;
+				reader->_autoPausedAt = ms;
 				it.key()->_autoPausedGif.storeRelease(1);
 				result = ProcessResult::Paused;
 			}
@@ -826,8 +883,7 @@ bool Manager::handleProcessResult(ReaderPrivate *reader, ProcessResult result, c
 
 Manager::ResultHandleState Manager::handleResult(ReaderPrivate *reader, ProcessResult result, crl::time ms) {
 	if (!handleProcessResult(reader, result, ms)) {
-		_loadLevel.fetchAndAddRelaxed(-1 * (reader->_width > 0 ? reader->_width * reader->_height : kAverageGifSize));
-		delete reader;
+		destroy(reader);
 		return ResultHandleRemove;
 	}
 
@@ -917,8 +973,7 @@ void Manager::process() {
 			QMutexLocker lock(&_readerPointersMutex);
 			auto it = constUnsafeFindReaderPointer(reader);
 			if (it == _readerPointers.cend()) {
-				_loadLevel.fetchAndAddRelaxed(-1 * (reader->_width > 0 ? reader->_width * reader->_height : kAverageGifSize));
-				delete reader;
+				destroy(reader);
 				i = _readers.erase(i);
 				continue;
 			}
@@ -928,6 +983,7 @@ void Manager::process() {
 		}
 		++i;
 	}
+	suspendPausedReaders();
 
 	ms = crl::now();
 	if (_needReProcess || minms <= ms) {
@@ -940,6 +996,49 @@ void Manager::process() {
 	_processingInThread = nullptr;
 }
 
+void Manager::destroy(ReaderPrivate *reader) {
+	_loadLevel.fetchAndAddRelaxed(-1 * (reader->_width > 0 ? reader->_width * reader->_height : kAverageGifSize));
+	reader->releaseFrames();
+	delete reader;
+}
+
+void Manager::suspendPausedReaders() {
+	auto paused = std::vector<ReaderPrivate*>();
+	for (auto i = _readers.begin(), e = _readers.end(); i != e; ++i) {
+		const auto reader = i.key();
+		if (reader->_autoPausedGif && reader->_implementation) {
+			paused.push_back(reader);
+		}
+	}
+	if (int(paused.size()) <= kMaxPausedDecoders) {
+		return;
+	}
+	ranges::sort(paused, ranges::greater(), &ReaderPrivate::_autoPausedAt);
+	for (const auto reader : paused | ranges::views::drop(kMaxPausedDecoders)) {
+		reader->suspend();
+	}
+}
+
+QImage Manager::takeFrameBuffer(QSize size) {
+	const auto i = ranges::find(_framesPool, size, &QImage::size);
+	if (i == end(_framesPool)) {
+		return QImage();
+	}
+	auto result = std::move(*i);
+	_framesPool.erase(i);
+	return result;
+}
+
+void Manager::putFrameBuffer(QImage &&image) {
+	if (image.isNull() || !image.isDetached()) {
+		return;
+	}
+	_framesPool.push_back(std::move(image));
+	if (_framesPool.size() > kMaxPooledFrames) {
+		_framesPool.pop_front();
+	}
+}
+
 void Manager::finish() {
 	_timer.stop();
 	clear();
@@ -958,6 +1057,7 @@ void Manager::clear() {
 		delete i.key();
 	}
 	_readers.clear();
+	_framesPool.clear();
 }
 
 Manager::~Manager() {
@@ -17,6 +17,7 @@ namespace {
 
 constexpr auto kMaxSingleReadAmount = 8 * 1024 * 1024;
 constexpr auto kMaxQueuedPackets = 1024;
+constexpr auto kSkipPrefetch = 10 * crl::time(1000);
 
 [[nodiscard]] bool UnreliableFormatDuration(
 		not_null<AVFormatContext*> format,
@@ -256,6 +257,80 @@ void File::Context::seekToPosition(
 	return logFatal(qstr("av_seek_frame"), error);
 }
 
+void File::Context::fillKeyframes(
+		not_null<AVFormatContext*> format,
+		const Stream &stream) {
+	_keyframes.clear();
+	_keyframesStreamIndex = stream.index;
+	_keyframesTimeBase = stream.timeBase;
+
+	const auto info = format->streams[stream.index];
+	const auto count = avformat_index_get_entries_count(info);
+	_keyframes.reserve(std::max(count, 0));
+	for (auto i = 0; i < count; ++i) {
+		const auto entry = avformat_index_get_entry(info, i);
+		if (!entry
+			|| !(entry->flags & AVINDEX_KEYFRAME)
+			|| entry->pos < 0
+			|| entry->timestamp == AV_NOPTS_VALUE) {
+			continue;
+		}
+		_keyframes.push_back({
+			.position = FFmpeg::PtsToTime(entry->timestamp, stream.timeBase),
+			.offset = entry->pos,
+		});
+	}
+	ranges::sort(_keyframes, ranges::less(), &Keyframe::position);
+}
+
+std::optional<int64> File::Context::keyframeOffset(
+		crl::time position) const {
+	// We seek with AVSEEK_FLAG_BACKWARD, so take the keyframe before.
+	const auto i = ranges::upper_bound(
+		_keyframes,
+		position,
+		ranges::less(),
+		&Keyframe::position);
+	if (i == begin(_keyframes)) {
+		return std::nullopt;
+	}
+	return (i - 1)->offset;
+}
+
+void File::Context::checkSkipPrefetch(const FFmpeg::Packet &packet) {
+	const auto &fields = packet.fields();
+	if (_keyframes.empty()
+		|| fields.stream_index != _keyframesStreamIndex
+		|| fields.pts == AV_NOPTS_VALUE) {
+		return;
+	}
+	const auto position = FFmpeg::PtsToTime(fields.pts, _keyframesTimeBase);
+	if (_nextSkipPrefetch != kTimeUnknown && position < _nextSkipPrefetch) {
+		return;
+	}
+	_nextSkipPrefetch = position + kSkipPrefetch;
+	if (!_prefetchOffset) {
+		_prefetchOffset = keyframeOffset(_nextSkipPrefetch);
+	}
+}
+
+void File::Context::processPrefetch() {
+	const auto requested = _prefetchRequested.exchange(kTimeUnknown);
+	if (requested != kTimeUnknown) {
+		if (const auto offset = keyframeOffset(requested)) {
+			_prefetchOffset = offset;
+		}
+	}
+	if (_prefetchOffset && _reader->prefetch(*_prefetchOffset)) {
+		_prefetchOffset = std::nullopt;
+	}
+}
+
+void File::Context::prefetchAt(crl::time position) {
+	_prefetchRequested = std::max(position, crl::time(0));
+	_reader->wakeFromSleep();
+}
+
 std::variant<FFmpeg::Packet, FFmpeg::AvErrorWrap> File::Context::readPacket() {
 	auto error = FFmpeg::AvErrorWrap();
 
@@ -316,6 +391,7 @@ void File::Context::start(StartOptions options) {
 		sendFullInCache(true);
 	}
 	if (options.seekable && (video.codec || audio.codec)) {
+		fillKeyframes(format.get(), video.codec ? video : audio);
 		seekToPosition(
 			format.get(),
 			video.codec ? video : audio,
@@ -360,6 +436,8 @@ void File::Context::readNextPacket() {
 		if (i == end(_queuedPackets)) {
 			return;
 		}
+		checkSkipPrefetch(*packet);
+		processPrefetch();
 		i->second.push_back(std::move(*packet));
 		if (i->second.size() == kMaxQueuedPackets) {
 			processQueuedPackets(SleepPolicy::Allowed);
@@ -405,6 +483,9 @@ void File::Context::processQueuedPackets(SleepPolicy policy) {
 			_reader->startSleep(&_semaphore);
 			_semaphore.acquire();
 			_reader->stopSleep();
+			if (!unroll()) {
+				processPrefetch();
+			}
 		} while (!unroll() && !_delegate->fileReadMore());
 	}
 }
@@ -490,6 +571,12 @@ void File::setLoaderPriority(int priority) {
 	_reader->setLoaderPriority(priority);
 }
 
+void File::prefetchAt(crl::time position) {
+	if (_context) {
+		_context->prefetchAt(position);
+	}
+}
+
 File::~File() {
 	stop();
 }
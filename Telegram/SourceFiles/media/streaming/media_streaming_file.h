@@ -42,6 +42,9 @@ public:
 	[[nodiscard]] bool isRemoteLoader() const;
 	void setLoaderPriority(int priority);
 
+	// Preload the data around the keyframe for a likely seek target.
+	void prefetchAt(crl::time position);
+
 	~File();
 
 private:
@@ -55,6 +58,7 @@ private:
 
 		void interrupt();
 		void wake();
+		void prefetchAt(crl::time position);
 		[[nodiscard]] bool interrupted() const;
 		[[nodiscard]] bool failed() const;
 		[[nodiscard]] bool finished() const;
@@ -66,6 +70,10 @@ private:
 			Allowed,
 			Disallowed,
 		};
+		struct Keyframe {
+			crl::time position = 0;
+			int64 offset = 0;
+		};
 		static int Read(void *opaque, uint8_t *buffer, int bufferSize);
 		static int64_t Seek(void *opaque, int64_t offset, int whence);
 
@@ -88,6 +96,13 @@ private:
 			not_null<AVFormatContext *> format,
 			const Stream &stream,
 			crl::time position);
+		void fillKeyframes(
+			not_null<AVFormatContext *> format,
+			const Stream &stream);
+		[[nodiscard]] std::optional<int64> keyframeOffset(
+			crl::time position) const;
+		void checkSkipPrefetch(const FFmpeg::Packet &packet);
+		void processPrefetch();
 
 		// TODO base::expected.
 		[[nodiscard]] auto readPacket()
@@ -109,6 +124,13 @@ private:
 		crl::semaphore _semaphore;
 		std::atomic<bool> _interrupted = false;
 
+		std::vector<Keyframe> _keyframes;
+		int _keyframesStreamIndex = -1;
+		AVRational _keyframesTimeBase = { 0, 0 };
+		crl::time _nextSkipPrefetch = kTimeUnknown;
+		std::optional<int64> _prefetchOffset;
+		std::atomic<crl::time> _prefetchRequested = kTimeUnknown;
+
 		FFmpeg::FormatPointer _format;
 
 	};
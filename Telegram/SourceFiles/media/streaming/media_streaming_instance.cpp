@@ -108,6 +108,12 @@ void Instance::saveFrameToCover() {
 	_shared->saveFrameToCover();
 }
 
+void Instance::prefetchAt(crl::time position) {
+	Expects(_shared != nullptr);
+
+	_shared->player().prefetchAt(position);
+}
+
 bool Instance::active() const {
 	Expects(_shared != nullptr);
 
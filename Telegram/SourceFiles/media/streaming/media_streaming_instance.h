@@ -52,6 +52,7 @@ public:
 	void stop();
 	void stopAudio();
 	void saveFrameToCover();
+	void prefetchAt(crl::time position);
 
 	[[nodiscard]] bool active() const;
 	[[nodiscard]] bool ready() const;
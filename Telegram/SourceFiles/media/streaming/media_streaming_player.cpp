@@ -147,6 +147,10 @@ void Player::setLoaderPriority(int priority) {
 	_file->setLoaderPriority(priority);
 }
 
+void Player::prefetchAt(crl::time position) {
+	_file->prefetchAt(position);
+}
+
 template <typename Track>
 void Player::trackReceivedTill(
 		const Track &track,
@@ -76,6 +76,7 @@ public:
 	bool markFrameShown();
 
 	void setLoaderPriority(int priority);
+	void prefetchAt(crl::time position);
 
 	[[nodiscard]] Media::Player::TrackState prepareLegacyState() const;
 
@@ -23,9 +23,17 @@ constexpr auto kMaxOnlyInHeader = 80 * kPartSize;
 constexpr auto kPartsOutsideFirstSliceGood = 8;
 constexpr auto kSlicesInMemory = 2;
 
+// All readers together may keep up to 128 MB of slices in memory,
+// but no more than 64 MB each, leaving 32 MB for the active players.
+constexpr auto kSlicesBudget = 16;
+constexpr auto kMaxSlicesInMemory = 8;
+constexpr auto kSlicesReservedForActive = 4;
+constexpr auto kActiveLoaderPriority = 2;
+
 // 1 MB of parts are requested from cloud ahead of reading demand.
 constexpr auto kPreloadPartsAhead = 8;
-constexpr auto kDownloaderRequestsLimit = 4;
+constexpr auto kPrefetchParts = 4;
+constexpr auto kDownloaderRequestsLimit = kPreloadPartsAhead;
 
 using PartsMap = base::flat_map<uint32, QByteArray>;
 
@@ -194,6 +202,75 @@ void CopyLoaded(
 	}
 }
 
+// Readers work on their own streaming threads, so each one unloads only
+// its own least recently used slices, down to the allowance it gets here.
+class SlicesBudget final {
+public:
+	[[nodiscard]] int allowed(const void *reader, int loaded, bool active);
+	void remove(const void *reader);
+
+	void hit();
+	void miss();
+	[[nodiscard]] ReaderSlicesStats stats() const;
+
+private:
+	struct Usage {
+		int loaded = 0;
+		bool active = false;
+	};
+
+	mutable QMutex _mutex;
+	base::flat_map<const void*, Usage> _readers;
+	int _loaded = 0;
+	std::atomic<int64> _hits = 0;
+	std::atomic<int64> _misses = 0;
+
+};
+
+int SlicesBudget::allowed(const void *reader, int loaded, bool active) {
+	QMutexLocker lock(&_mutex);
+	auto &usage = _readers[reader];
+	_loaded += loaded - usage.loaded;
+	usage = { .loaded = loaded, .active = active };
+
+	const auto others = _loaded - loaded;
+	const auto reserved = active ? 0 : kSlicesReservedForActive;
+	return std::clamp(
+		kSlicesBudget - others - reserved,
+		kSlicesInMemory,
+		kMaxSlicesInMemory);
+}
+
+void SlicesBudget::remove(const void *reader) {
+	QMutexLocker lock(&_mutex);
+	if (const auto usage = _readers.take(reader)) {
+		_loaded -= usage->loaded;
+	}
+}
+
+void SlicesBudget::hit() {
+	++_hits;
+}
+
+void SlicesBudget::miss() {
+	++_misses;
+}
+
+ReaderSlicesStats SlicesBudget::stats() const {
+	QMutexLocker lock(&_mutex);
+	return {
+		.hits = _hits.load(),
+		.misses = _misses.load(),
+		.bytesInMemory = int64(_loaded) * kInSlice,
+		.readers = int(_readers.size()),
+	};
+}
+
+[[nodiscard]] SlicesBudget &Budget() {
+	static auto result = SlicesBudget();
+	return result;
+}
+
 } // namespace
 
 template <int Size>
@@ -341,7 +418,8 @@ auto Reader::Slice::offsetsFromLoader(uint32 from, uint32 till) const
 }
 
 Reader::Slices::Slices(uint32 size, bool useCache)
-: _size(size) {
+: _maxSlicesInMemory(kSlicesInMemory)
+, _size(size) {
 	Expects(size > 0);
 
 	if (useCache) {
@@ -457,6 +535,9 @@ void Reader::Slices::processCacheResult(int sliceNumber, PartsMap &&result) {
 		return;
 	}
 	slice.processCacheData(std::move(result));
+	if (sliceNumber > 0 && (slice.flags & Slice::Flag::Prefetched)) {
+		markSlicePrefetched(sliceNumber - 1);
+	}
 	checkSliceFullLoaded(sliceNumber);
 	if (!sliceNumber) {
 		applyHeaderCacheData();
@@ -545,9 +626,60 @@ void Reader::Slices::processPart(
 	}
 	const auto index = offset / kInSlice;
 	_data[index].addPart(offset - index * kInSlice, std::move(bytes));
+	if (_data[index].flags & Slice::Flag::Prefetched) {
+		markSlicePrefetched(index);
+	}
 	checkSliceFullLoaded(index + 1);
 }
 
+auto Reader::Slices::prefetch(uint32 offset) -> FillResult {
+	Expects(offset < _size);
+
+	using Flag = Slice::Flag;
+
+	auto result = FillResult();
+	result.state = FillState::Success;
+	if (_headerMode == HeaderMode::Unknown || isFullInHeader()) {
+		return result;
+	}
+	const auto sliceIndex = int(offset / kInSlice);
+	if (!sliceIndex || sliceIndex >= _data.size()) {
+		// The first slice is loaded together with the header anyway.
+		return result;
+	}
+	auto &slice = _data[sliceIndex];
+	if (slice.flags & Flag::FullInCache) {
+		return result;
+	} else if (!ranges::contains(_usedSlices, sliceIndex)
+		&& _usedSlices.size() >= _maxSlicesInMemory) {
+		// Don't push the slices used by the playback out of the memory.
+		return result;
+	}
+	markSlicePrefetched(sliceIndex);
+	if (_headerMode != HeaderMode::NoCache
+		&& !(slice.flags & Flag::LoadedFromCache)) {
+		// Find out which parts we have in cache before loading any.
+		if (!(slice.flags & Flag::LoadingFromCache)) {
+			slice.flags |= Flag::LoadingFromCache;
+			result.sliceNumbersFromCache.add(sliceIndex + 1);
+		}
+		result.state = FillState::WaitingCache;
+		return result;
+	}
+	const auto from = uint32(
+		(offset - sliceIndex * kInSlice) / kPartSize * kPartSize);
+	const auto till = std::min(
+		uint32(from + kPrefetchParts * kPartSize),
+		kInSlice);
+	for (const auto local : slice.offsetsFromLoader(from, till).values()) {
+		const auto full = local + sliceIndex * kInSlice;
+		if (local < kInSlice && full < _size) {
+			result.offsetsFromLoader.add(full);
+		}
+	}
+	return result;
+}
+
 auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 	Expects(!buffer.empty());
 	Expects(offset < _size);
@@ -692,7 +824,16 @@ bool Reader::Slices::readCacheForDownloaderRequired(uint32 offset) {
 	return !(slice.flags & Slice::Flag::LoadedFromCache);
 }
 
+int Reader::Slices::slicesInMemory() const {
+	return int(_usedSlices.size());
+}
+
+void Reader::Slices::setMaxSlicesInMemory(int count) {
+	_maxSlicesInMemory = count;
+}
+
 void Reader::Slices::markSliceUsed(int sliceIndex) {
+	_data[sliceIndex].flags &= ~Slice::Flag::Prefetched;
 	const auto i = ranges::find(_usedSlices, sliceIndex);
 	const auto end = _usedSlices.end();
 	if (i == end) {
@@ -705,6 +846,14 @@ void Reader::Slices::markSliceUsed(int sliceIndex) {
 	}
 }
 
+void Reader::Slices::markSlicePrefetched(int sliceIndex) {
+	// Prefetched slices are the first to be unloaded, until really used.
+	if (!ranges::contains(_usedSlices, sliceIndex)) {
+		_data[sliceIndex].flags |= Slice::Flag::Prefetched;
+		_usedSlices.push_front(sliceIndex);
+	}
+}
+
 int Reader::Slices::maxSliceSize(int sliceNumber) const {
 	return MaxSliceSize(sliceNumber, _size);
 }
@@ -713,12 +862,16 @@ Reader::SerializedSlice Reader::Slices::serializeAndUnloadUnused() {
 	using Flag = Slice::Flag;
 
 	if (_headerMode == HeaderMode::Unknown
-		|| _usedSlices.size() <= kSlicesInMemory) {
+		|| _usedSlices.size() <= _maxSlicesInMemory) {
 		return {};
 	}
 	const auto purgeSlice = _usedSlices.front();
 	_usedSlices.pop_front();
 	if (!(_data[purgeSlice].flags & Flag::LoadedFromCache)) {
+		if (_data[purgeSlice].flags & Flag::Prefetched) {
+			// Drop the prefetch still waiting for the cache read.
+			unloadSlice(_data[purgeSlice]);
+		}
 		// If the only data in this slice was from _header, just leave it.
 		return {};
 	}
@@ -799,11 +952,12 @@ Reader::SerializedSlice Reader::Slices::serializeAndUnloadSlice(
 }
 
 void Reader::Slices::unloadSlice(Slice &slice) const {
-	const auto full = (slice.flags & Slice::Flag::FullInCache);
+	using Flag = Slice::Flag;
+
+	// Parts of a prefetch arriving later should be tracked again.
+	const auto kept = slice.flags & (Flag::FullInCache | Flag::Prefetched);
 	slice = Slice();
-	if (full) {
-		slice.flags |= Slice::Flag::FullInCache;
-	}
+	slice.flags = kept;
 }
 
 QByteArray Reader::Slices::serializeComplexSlice(const Slice &slice) const {
@@ -1109,6 +1263,8 @@ void Reader::setLoaderPriority(int priority) {
 
 void Reader::refreshLoaderPriority() {
 	_loader->setPriority(_streamingActive ? _realPriority : 0);
+	_activeForBudget = _streamingActive
+		&& (_realPriority >= kActiveLoaderPriority);
 }
 
 bool Reader::isRemoteLoader() const {
@@ -1262,7 +1418,16 @@ Reader::FillState Reader::fill(
 Reader::FillState Reader::fillFromSlices(uint32 offset, bytes::span buffer) {
 	using namespace rpl::mappers;
 
+	_slices.setMaxSlicesInMemory(Budget().allowed(
+		this,
+		_slices.slicesInMemory(),
+		_activeForBudget.load(std::memory_order_relaxed)));
 	auto result = _slices.fill(offset, buffer);
+	if (result.state == FillState::Success) {
+		Budget().hit();
+	} else {
+		Budget().miss();
+	}
 	if (result.state != FillState::Success && _slices.headerWontBeFilled()) {
 		_streamingError = Error::NotStreamable;
 		return FillState::Failed;
@@ -1378,6 +1543,29 @@ void Reader::loadAtOffset(uint32 offset) {
 	}
 }
 
+bool Reader::prefetch(int64 offset) {
+	if (_streamingError || offset < 0 || offset >= size()) {
+		return true;
+	}
+	checkForSomethingMoreReceived();
+	if (!_loadingOffsets.empty()) {
+		// Don't compete with the parts required for the playback.
+		return false;
+	}
+	_slices.setMaxSlicesInMemory(Budget().allowed(
+		this,
+		_slices.slicesInMemory(),
+		_activeForBudget.load(std::memory_order_relaxed)));
+	const auto result = _slices.prefetch(uint32(offset));
+	for (const auto sliceNumber : result.sliceNumbersFromCache.values()) {
+		readFromCache(sliceNumber);
+	}
+	for (const auto offset : result.offsetsFromLoader.values()) {
+		loadAtOffset(offset);
+	}
+	return (result.state != FillState::WaitingCache);
+}
+
 void Reader::finalizeCache() {
 	if (!_cacheHelper) {
 		return;
@@ -1393,6 +1581,11 @@ void Reader::finalizeCache() {
 
 Reader::~Reader() {
 	finalizeCache();
+	Budget().remove(this);
+}
+
+ReaderSlicesStats CollectReaderSlicesStats() {
+	return Budget().stats();
 }
 
 QByteArray SerializeComplexPartsMap(
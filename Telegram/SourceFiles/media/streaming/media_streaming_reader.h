@@ -30,6 +30,13 @@ class Loader;
 struct LoadedPart;
 enum class Error;
 
+struct ReaderSlicesStats {
+	int64 hits = 0;
+	int64 misses = 0;
+	int64 bytesInMemory = 0;
+	int readers = 0;
+};
+
 class Reader final : public base::has_weak_ptr {
 public:
 	enum class FillState : uchar {
@@ -60,6 +67,10 @@ public:
 	[[nodiscard]] int headerSize() const;
 	[[nodiscard]] bool fullInCache() const;
 
+	// Loads a few parts at offset if nothing is loading for the playback.
+	// Returns false if it should be called once again later.
+	[[nodiscard]] bool prefetch(int64 offset);
+
 	// Thread safe.
 	void startSleep(not_null<crl::semaphore*> wake);
 	void wakeFromSleep();
@@ -119,6 +130,7 @@ private:
 			LoadedFromCache = 0x02,
 			ChangedSinceCache = 0x04,
 			FullInCache = 0x08,
+			Prefetched = 0x10,
 		};
 		friend constexpr inline bool is_flag_type(Flag) { return true; }
 		using Flags = base::flags<Flag>;
@@ -158,12 +170,15 @@ private:
 		[[nodiscard]] bool waitingForHeaderCache() const;
 
 		[[nodiscard]] int requestSliceSizesCount() const;
+		[[nodiscard]] int slicesInMemory() const;
+		void setMaxSlicesInMemory(int count);
 
 		void processCacheResult(int sliceNumber, PartsMap &&result);
 		void processCachedSizes(const std::vector<int> &sizes);
 		void processPart(uint32 offset, QByteArray &&bytes);
 
 		[[nodiscard]] FillResult fill(uint32 offset, bytes::span buffer);
+		[[nodiscard]] FillResult prefetch(uint32 offset);
 		[[nodiscard]] SerializedSlice unloadToCache();
 
 		[[nodiscard]] QByteArray partForDownloader(uint32 offset) const;
@@ -187,6 +202,7 @@ private:
 			const Slice &slice) const;
 		[[nodiscard]] QByteArray serializeAndUnloadFirstSliceNoHeader();
 		void markSliceUsed(int sliceIndex);
+		void markSlicePrefetched(int sliceIndex);
 		[[nodiscard]] bool computeIsGoodHeader() const;
 		[[nodiscard]] FillResult fillFromHeader(
 			uint32 offset,
@@ -198,6 +214,7 @@ private:
 		std::vector<Slice> _data;
 		Slice _header;
 		std::deque<int> _usedSlices;
+		int _maxSlicesInMemory = 0;
 		uint32 _size = 0;
 		HeaderMode _headerMode = HeaderMode::Unknown;
 		bool _fullInCache = false;
@@ -247,6 +264,7 @@ private:
 	std::atomic<crl::semaphore*> _waiting = nullptr;
 	std::atomic<crl::semaphore*> _sleeping = nullptr;
 	std::atomic<bool> _stopStreamingAsync = false;
+	std::atomic<bool> _activeForBudget = false;
 	PriorityQueue _loadingOffsets;
 
 	Slices _slices;
@@ -280,5 +298,8 @@ private:
 [[nodiscard]] QByteArray SerializeComplexPartsMap(
 	const base::flat_map<uint32, QByteArray> &parts);
 
+// Thread safe, counts fill() calls served from the slices in memory.
+[[nodiscard]] ReaderSlicesStats CollectReaderSlicesStats();
+
 } // namespace Streaming
 } // namespace Media
@@ -131,6 +131,74 @@ bool TransferFrame(
 	return true;
 }
 
+bool HighBitDepthYUV(int format) {
+	switch (format) {
+	case AV_PIX_FMT_P010:
+	case AV_PIX_FMT_P016:
+	case AV_PIX_FMT_YUV420P10:
+	case AV_PIX_FMT_YUV420P12:
+		return true;
+	}
+	return false;
+}
+
+bool ReduceBitDepth(
+		Stream &stream,
+		not_null<AVFrame*> frame,
+		not_null<AVFrame*> storage) {
+	Expects(HighBitDepthYUV(frame->format));
+
+	// Semi-planar formats come from hardware decoders, keep them NV12,
+	// so that the renderer still uploads the planes without conversion.
+	const auto format = (frame->format == AV_PIX_FMT_P010
+		|| frame->format == AV_PIX_FMT_P016)
+		? AV_PIX_FMT_NV12
+		: AV_PIX_FMT_YUV420P;
+	const auto size = QSize(frame->width, frame->height);
+	if (size.isEmpty() || !FFmpeg::FrameHasData(frame)) {
+		LOG(("Streaming Error: Bad frame for bit depth reduce."));
+		return false;
+	} else if (storage->format != format
+		|| storage->width != size.width()
+		|| storage->height != size.height()) {
+		FFmpeg::ClearFrameMemory(storage);
+		storage->format = format;
+		storage->width = size.width();
+		storage->height = size.height();
+	}
+	auto error = FFmpeg::AvErrorWrap();
+	if (!FFmpeg::FrameHasData(storage)) {
+		if ((error = av_frame_get_buffer(storage, 0))) {
+			LogError(u"av_frame_get_buffer"_q, error);
+			return false;
+		}
+	} else if ((error = av_frame_make_writable(storage))) {
+		LogError(u"av_frame_make_writable"_q, error);
+		return false;
+	}
+	stream.swscale = FFmpeg::MakeSwscalePointer(
+		size,
+		frame->format,
+		size,
+		format,
+		&stream.swscale);
+	if (!stream.swscale) {
+		return false;
+	}
+	sws_scale(
+		stream.swscale.get(),
+		frame->data,
+		frame->linesize,
+		0,
+		frame->height,
+		storage->data,
+		storage->linesize);
+	storage->colorspace = frame->colorspace;
+	storage->color_range = frame->color_range;
+	FFmpeg::ClearFrameMemory(frame);
+	return true;
+}
+
 QImage ConvertFrame(
 		Stream &stream,
 		not_null<AVFrame*> frame,
@@ -59,6 +59,11 @@ struct Stream {
 	Stream &stream,
 	not_null<AVFrame*> decodedFrame,
 	not_null<AVFrame*> transferredFrame);
+[[nodiscard]] bool HighBitDepthYUV(int format);
+[[nodiscard]] bool ReduceBitDepth(
+	Stream &stream,
+	not_null<AVFrame*> frame,
+	not_null<AVFrame*> storage);
 [[nodiscard]] QImage ConvertFrame(
 	Stream &stream,
 	not_null<AVFrame*> frame,
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/audio/media_audio.h"
 #include "base/concurrent_timer.h"
 #include "core/crash_reports.h"
+#include "core/tracing.h"
 #include "base/debug_log.h"
 
 namespace Media {
@@ -353,6 +354,7 @@ crl::time VideoTrackObject::computeDuration() const {
 }
 
 auto VideoTrackObject::readFrame(not_null<Frame*> frame) -> FrameResult {
+	TRACE_SCOPE("Streaming::VideoTrackObject::readFrame");
 	if (const auto error = ReadNextFrame(_stream)) {
 		if (error.code() == AVERROR_EOF) {
 			if (!_options.loop) {
@@ -455,9 +457,22 @@ void VideoTrackObject::rasterizeFrame(not_null<Frame*> frame) {
 	} else {
 		frame->transferred = nullptr;
 	}
-	const auto frameWithData = frame->transferred
+	auto frameWithData = frame->transferred
 		? frame->transferred.get()
 		: frame->decoded.get();
+	if (HighBitDepthYUV(frameWithData->format) && !requireARGB32()) {
+		if (!frame->reduced) {
+			frame->reduced = FFmpeg::MakeFramePointer();
+		}
+		if (!ReduceBitDepth(_stream, frameWithData, frame->reduced.get())) {
+			frame->prepared.clear();
+			fail(Error::InvalidData);
+			return;
+		}
+		frameWithData = frame->reduced.get();
+	} else {
+		frame->reduced = nullptr;
+	}
 	if ((frameWithData->format == AV_PIX_FMT_YUV420P
 		|| frameWithData->format == AV_PIX_FMT_NV12) && !requireARGB32()) {
 		const auto nv12 = (frameWithData->format == AV_PIX_FMT_NV12);
@@ -83,6 +83,7 @@ private:
 	struct Frame {
 		FFmpeg::FramePointer decoded = FFmpeg::MakeFramePointer();
 		FFmpeg::FramePointer transferred;
+		FFmpeg::FramePointer reduced;
 		QImage original;
 		FrameYUV yuv;
 		crl::time position = kTimeUnknown;
@@ -12,44 +12,79 @@ namespace MTP::details {
 ReceivedIdsManager::Result ReceivedIdsManager::registerMsgId(
 		mtpMsgId msgId,
 		bool needAck) {
-	const auto i = _idsNeedAck.find(msgId);
-	if (i != _idsNeedAck.end()) {
+	auto slot = findSlot(msgId);
+	if (_slots[slot]) {
 		MTP_LOG(-1, ("No need to handle - %1 already is in map").arg(msgId));
 		return Result::Duplicate;
-	} else if (_idsNeedAck.size() < kIdsBufferSize || msgId > min()) {
-		_idsNeedAck.emplace(msgId, needAck);
-		return Result::Success;
+	} else if (msgId <= _forgottenMax) {
+		MTP_LOG(-1, ("Reset on too old - %1 <= forgotten = %2"
+			).arg(msgId
+			).arg(_forgottenMax));
+		return Result::TooOld;
 	}
-	MTP_LOG(-1, ("Reset on too old - %1 < min = %2").arg(msgId).arg(min()));
-	return Result::TooOld;
+	if (_count == kWindow) {
+		forget(_next);
+		slot = findSlot(msgId);
+	}
+	_ids[_next] = msgId;
+	_needAck[_next] = needAck;
+	_slots[slot] = uint16(_next + 1);
+	_next = (_next + 1) % kWindow;
+	++_count;
+	return Result::Success;
 }
 
-mtpMsgId ReceivedIdsManager::min() const {
-	return _idsNeedAck.empty() ? 0 : _idsNeedAck.begin()->first;
+ReceivedIdsManager::State ReceivedIdsManager::lookup(mtpMsgId msgId) const {
+	const auto stored = _slots[findSlot(msgId)];
+	if (!stored) {
+		return State::NotFound;
+	}
+	return _needAck[stored - 1] ? State::NeedsAck : State::NoAckNeeded;
 }
 
-mtpMsgId ReceivedIdsManager::max() const {
-	auto end = _idsNeedAck.end();
-	return _idsNeedAck.empty() ? 0 : (--end)->first;
+void ReceivedIdsManager::clear() {
+	_slots.fill(0);
+	_count = 0;
+	_next = 0;
+	_forgottenMax = 0;
 }
 
-ReceivedIdsManager::State ReceivedIdsManager::lookup(mtpMsgId msgId) const {
-	auto i = _idsNeedAck.find(msgId);
-	if (i == _idsNeedAck.end()) {
-		return State::NotFound;
-	}
-	return i->second ? State::NeedsAck : State::NoAckNeeded;
+int ReceivedIdsManager::Hash(mtpMsgId msgId) {
+	constexpr auto kShift = 64 - 11;
+	static_assert((1 << (64 - kShift)) == kSlots);
+
+	return int((uint64(msgId) * 0x9E3779B97F4A7C15ULL) >> kShift);
 }
 
-void ReceivedIdsManager::shrink() {
-	auto size = _idsNeedAck.size();
-	while (size-- > kIdsBufferSize) {
-		_idsNeedAck.erase(_idsNeedAck.begin());
+int ReceivedIdsManager::findSlot(mtpMsgId msgId) const {
+	auto slot = Hash(msgId);
+	while (const auto stored = _slots[slot]) {
+		if (_ids[stored - 1] == msgId) {
+			break;
+		}
+		slot = (slot + 1) & (kSlots - 1);
 	}
+	return slot;
 }
 
-void ReceivedIdsManager::clear() {
-	_idsNeedAck.clear();
+void ReceivedIdsManager::forget(int position) {
+	const auto msgId = _ids[position];
+	_forgottenMax = std::max(_forgottenMax, msgId);
+	--_count;
+
+	// Backward shift deletion keeps the probe chains unbroken.
+	auto hole = findSlot(msgId);
+	for (auto slot = (hole + 1) & (kSlots - 1)
+		; _slots[slot]
+		; slot = (slot + 1) & (kSlots - 1)) {
+		const auto ideal = Hash(_ids[_slots[slot] - 1]);
+		const auto distance = (slot - ideal) & (kSlots - 1);
+		if (distance >= ((slot - hole) & (kSlots - 1))) {
+			_slots[hole] = _slots[slot];
+			hole = slot;
+		}
+	}
+	_slots[hole] = 0;
 }
 
 } // namespace MTP::details
@@ -7,7 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
-#include "base/flat_map.h"
+#include <bitset>
 
 namespace MTP::details {
 
@@ -28,15 +28,25 @@ public:
 	};
 
 	[[nodiscard]] Result registerMsgId(mtpMsgId msgId, bool needAck);
-	[[nodiscard]] mtpMsgId min() const;
-	[[nodiscard]] mtpMsgId max() const;
 	[[nodiscard]] State lookup(mtpMsgId msgId) const;
 
-	void shrink();
 	void clear();
 
 private:
-	base::flat_map<mtpMsgId, bool> _idsNeedAck;
+	// Last received msgIds in a ring, indexed by an open addressing table.
+	static constexpr auto kWindow = 1024;
+	static constexpr auto kSlots = 2 * kWindow;
+
+	[[nodiscard]] static int Hash(mtpMsgId msgId);
+	[[nodiscard]] int findSlot(mtpMsgId msgId) const;
+	void forget(int position);
+
+	std::array<mtpMsgId, kWindow> _ids = {};
+	std::bitset<kWindow> _needAck;
+	std::array<uint16, kSlots> _slots = {}; // Ring position + 1, or 0.
+	int _count = 0;
+	int _next = 0;
+	mtpMsgId _forgottenMax = 0;
 
 };
 
@@ -0,0 +1,170 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_request_stats.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+namespace MTP::details {
+namespace {
+
+constexpr auto kDumpInterval = 10 * 60 * crl::time(1000);
+constexpr auto kFirstBucketLatency = crl::time(50);
+
+[[nodiscard]] mtpTypeId ComputeMethod(const SerializedRequest &request) {
+	const auto &data = *request;
+	auto offset = int(SerializedRequest::kMessageBodyPosition);
+	while (offset < data.size()) {
+		// Look through the wrappers to the actual method.
+		const auto type = mtpTypeId(data[offset]);
+		if (type == mtpc_invokeWithoutUpdates) {
+			offset += 1;
+		} else if (type == mtpc_invokeWithTakeout) {
+			offset += 3;
+		} else {
+			return type;
+		}
+	}
+	return 0;
+}
+
+[[nodiscard]] int ComputeBucket(crl::time latency, int buckets) {
+	auto result = 0;
+	auto limit = kFirstBucketLatency;
+	while (result + 1 < buckets && latency >= limit) {
+		++result;
+		limit *= 2;
+	}
+	return result;
+}
+
+} // namespace
+
+void RequestStats::sent(
+		mtpRequestId requestId,
+		const SerializedRequest &request,
+		ShiftedDcId shiftedDcId) {
+	const auto now = crl::now();
+	const auto method = ComputeMethod(request);
+	const auto bytes = int(request->size() * sizeof(mtpPrime));
+
+	QMutexLocker lock(&_mutex);
+	_pending[requestId] = Pending{
+		.method = method,
+		.dcId = shiftedDcId,
+		.enqueued = now,
+		.bytesOut = bytes,
+	};
+}
+
+void RequestStats::received(mtpRequestId requestId, int bytes, bool error) {
+	QMutexLocker lock(&_mutex);
+	const auto i = _pending.find(requestId);
+	if (i != end(_pending)) {
+		i->second.bytesIn += bytes;
+		i->second.failed = error;
+	}
+}
+
+void RequestStats::delayed(mtpRequestId requestId, bool floodWait) {
+	QMutexLocker lock(&_mutex);
+	const auto i = _pending.find(requestId);
+	if (i != end(_pending)) {
+		++i->second.retries;
+		if (floodWait) {
+			++i->second.floodWaits;
+		}
+	}
+}
+
+void RequestStats::finished(
+		mtpRequestId requestId,
+		const SerializedRequest &request) {
+	const auto now = crl::now();
+
+	QMutexLocker lock(&_mutex);
+	const auto i = _pending.find(requestId);
+	if (i == end(_pending)) {
+		return;
+	}
+	const auto pending = i->second;
+	_pending.erase(i);
+
+	// firstSentTime is set when the session first writes the request,
+	// unlike lastSentTime it isn't updated by the session resends.
+	const auto firstSent = (request && request->firstSentTime > 0)
+		? std::clamp(request->firstSentTime, pending.enqueued, now)
+		: pending.enqueued;
+	const auto latency = now - pending.enqueued;
+	auto &summary = _summaries[Key{ pending.dcId, pending.method }];
+	++summary.count;
+	if (pending.failed) {
+		++summary.failed;
+	}
+	summary.retries += pending.retries;
+	summary.floodWaits += pending.floodWaits;
+	summary.bytesOut += pending.bytesOut * (1 + pending.retries);
+	summary.bytesIn += pending.bytesIn;
+	summary.latencyTotal += latency;
+	summary.latencyMax = std::max(summary.latencyMax, latency);
+	summary.queuedTotal += (firstSent - pending.enqueued);
+	++summary.buckets[ComputeBucket(latency, kBuckets)];
+
+	if (dumpRequired(now)) {
+		lock.unlock();
+		DEBUG_LOG(("MTP Stats: %1").arg(QString::fromUtf8(toJson())));
+	}
+}
+
+void RequestStats::cancelled(mtpRequestId requestId) {
+	QMutexLocker lock(&_mutex);
+	_pending.erase(requestId);
+}
+
+bool RequestStats::dumpRequired(crl::time now) {
+	if (!_lastDump) {
+		_lastDump = now;
+		return false;
+	} else if (now - _lastDump < kDumpInterval) {
+		return false;
+	}
+	_lastDump = now;
+	return Logs::DebugEnabled();
+}
+
+QByteArray RequestStats::toJson() const {
+	QMutexLocker lock(&_mutex);
+	auto list = QJsonArray();
+	for (const auto &[key, summary] : _summaries) {
+		auto buckets = QJsonArray();
+		for (const auto count : summary.buckets) {
+			buckets.append(count);
+		}
+		list.append(QJsonObject{
+			{ "dc", key.dcId },
+			{ "method", QString("0x%1").arg(key.method, 8, 16, QChar('0')) },
+			{ "count", summary.count },
+			{ "failed", summary.failed },
+			{ "retries", summary.retries },
+			{ "flood_waits", summary.floodWaits },
+			{ "bytes_out", double(summary.bytesOut) },
+			{ "bytes_in", double(summary.bytesIn) },
+			{ "latency_avg", double(summary.latencyTotal) / summary.count },
+			{ "latency_max", double(summary.latencyMax) },
+			{ "queued_avg", double(summary.queuedTotal) / summary.count },
+			{ "latency_histogram", buckets },
+		});
+	}
+	return QJsonDocument(QJsonObject{
+		{ "bucket_first_ms", double(kFirstBucketLatency) },
+		{ "requests", list },
+	}).toJson(QJsonDocument::Compact);
+}
+
+} // namespace MTP::details
@@ -0,0 +1,79 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "mtproto/details/mtproto_serialized_request.h"
+#include "base/flat_map.h"
+
+#include <QtCore/QMutex>
+
+#include <map>
+
+namespace MTP::details {
+
+// Per dc and method latency, traffic and retries of finished requests.
+// Written to the debug log as JSON once in a while.
+class RequestStats final {
+public:
+	void sent(
+		mtpRequestId requestId,
+		const SerializedRequest &request,
+		ShiftedDcId shiftedDcId);
+	void received(mtpRequestId requestId, int bytes, bool error);
+	void delayed(mtpRequestId requestId, bool floodWait);
+	void finished(
+		mtpRequestId requestId,
+		const SerializedRequest &request);
+	void cancelled(mtpRequestId requestId);
+
+	[[nodiscard]] QByteArray toJson() const;
+
+private:
+	// Latency buckets: < 50ms, < 100ms, ... < 3200ms and the rest.
+	static constexpr auto kBuckets = 8;
+
+	struct Pending {
+		mtpTypeId method = 0;
+		ShiftedDcId dcId = 0;
+		crl::time enqueued = 0;
+		int bytesOut = 0;
+		int bytesIn = 0;
+		int retries = 0;
+		int floodWaits = 0;
+		bool failed = false;
+	};
+	struct Key {
+		ShiftedDcId dcId = 0;
+		mtpTypeId method = 0;
+
+		friend inline auto operator<=>(Key, Key) = default;
+		friend inline bool operator==(Key, Key) = default;
+	};
+	struct Summary {
+		int count = 0;
+		int failed = 0;
+		int retries = 0;
+		int floodWaits = 0;
+		int64 bytesOut = 0;
+		int64 bytesIn = 0;
+		crl::time latencyTotal = 0;
+		crl::time latencyMax = 0;
+		crl::time queuedTotal = 0;
+		std::array<int, kBuckets> buckets = { { 0 } };
+	};
+
+	[[nodiscard]] bool dumpRequired(crl::time now);
+
+	mutable QMutex _mutex;
+	std::map<mtpRequestId, Pending> _pending;
+	base::flat_map<Key, Summary> _summaries;
+	crl::time _lastDump = 0;
+
+};
+
+} // namespace MTP::details
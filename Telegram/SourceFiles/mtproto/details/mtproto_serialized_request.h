@@ -89,6 +89,7 @@ public:
 
 	SerializedRequest after;
 	crl::time lastSentTime = 0;
+	crl::time firstSentTime = 0; // Not updated by resends.
 	mtpRequestId requestId = 0;
 	bool needsLayer = false;
 	bool forceSendInContainer = false;
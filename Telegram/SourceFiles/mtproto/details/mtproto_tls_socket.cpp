@@ -781,12 +781,14 @@ void TlsSocket::readData() {
 	}
 }
 
-bool TlsSocket::checkNextPacket() {
-	auto offset = 0;
+bool TlsSocket::checkNextPacket(int offset) {
 	const auto incoming = bytes::make_span(_incoming);
 	while (!_incomingGoodDataLimit) {
 		const auto fullHeader = kServerHeader.size() + kLengthSize;
 		if (incoming.size() <= offset + fullHeader) {
+			if (offset > 0) {
+				shiftIncomingBy(offset);
+			}
 			return true;
 		}
 		if (!CheckPart(incoming.subspan(offset), kServerHeader)) {
@@ -797,10 +799,12 @@ bool TlsSocket::checkNextPacket() {
 			incoming,
 			offset + kServerHeader.size());
 		if (length > 0) {
-			if (offset > 0) {
+			// Don't move the whole buffer after each of many small records.
+			if (offset > 0 && offset * 2 >= int(incoming.size())) {
 				shiftIncomingBy(offset);
+				offset = 0;
 			}
-			_incomingGoodDataOffset = fullHeader;
+			_incomingGoodDataOffset = offset + fullHeader;
 			_incomingGoodDataLimit = length;
 		} else {
 			offset += kServerHeader.size() + kLengthSize + length;
@@ -871,8 +875,7 @@ int64 TlsSocket::read(bytes::span buffer) {
 		if (_incomingGoodDataLimit) {
 			return written;
 		}
-		shiftIncomingBy(base::take(_incomingGoodDataOffset));
-		if (!checkNextPacket()) {
+		if (!checkNextPacket(base::take(_incomingGoodDataOffset))) {
 			_state = State::Error;
 			InvokeQueued(this, [=] { handleError(); });
 			return written;
@@ -52,7 +52,7 @@ private:
 	void checkHelloParts34(int parts123Size);
 	void checkHelloDigest();
 	void readData();
-	[[nodiscard]] bool checkNextPacket();
+	[[nodiscard]] bool checkNextPacket(int offset = 0);
 	void shiftIncomingBy(int amount);
 
 	const bytes::vector _secret;
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtp_instance.h"
 
 #include "mtproto/details/mtproto_dcenter.h"
+#include "mtproto/details/mtproto_request_stats.h"
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/special_config_request.h"
 #include "mtproto/session.h"
@@ -276,6 +277,8 @@ private:
 
 	std::map<mtpRequestId, int> _requestsDelays;
 
+	RequestStats _requestStats;
+
 	std::set<mtpRequestId> _badGuestDcRequests;
 
 	std::map<DcId, std::vector<mtpRequestId>> _authWaiters;
@@ -664,6 +667,7 @@ void Instance::Private::cancel(mtpRequestId requestId) {
 			_requestMap.erase(it);
 		}
 	}
+	_requestStats.cancelled(requestId);
 	unregisterRequest(requestId);
 	if (shiftedDcId) {
 		const auto session = getSession(qAbs(*shiftedDcId));
@@ -1025,6 +1029,7 @@ void Instance::Private::sendRequest(
 	}
 	request->lastSentTime = crl::now();
 	request->needsLayer = needsLayer;
+	_requestStats.sent(requestId, request, realShiftedDcId);
 
 	session->sendPrepared(request, msCanWait);
 }
@@ -1043,7 +1048,11 @@ void Instance::Private::unregisterRequest(mtpRequestId requestId) {
 
 	{
 		QWriteLocker locker(&_requestMapLock);
-		_requestMap.erase(requestId);
+		const auto i = _requestMap.find(requestId);
+		if (i != end(_requestMap)) {
+			_requestStats.finished(requestId, i->second);
+			_requestMap.erase(i);
+		}
 	}
 	{
 		QMutexLocker locker(&_requestByDcLock);
@@ -1125,6 +1134,10 @@ bool Instance::Private::hasCallback(mtpRequestId requestId) const {
 
 void Instance::Private::processCallback(const Response &response) {
 	const auto requestId = response.requestId;
+	_requestStats.received(
+		requestId,
+		response.reply.size() * sizeof(mtpPrime),
+		(response.reply.isEmpty() || response.reply[0] == mtpc_rpc_error));
 	ResponseHandler handler;
 	{
 		QMutexLocker locker(&_parserMapLock);
@@ -1479,6 +1492,10 @@ bool Instance::Private::onErrorDefault(
 			return false;
 		}
 
+		_requestStats.delayed(
+			requestId,
+			m1.hasMatch() || m2.hasMatch()); // Not SLOWMODE_WAIT_.
+
 		auto secs = 1;
 		auto nonPremiumDelay = false;
 		if (code < 0 || code >= 500) {
@@ -10,8 +10,51 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 
 #include <QtCore/QDataStream>
+#include <openssl/evp.h>
 
 namespace MTP {
+namespace {
+
+constexpr auto kBlockSize = 16;
+
+// EVP ciphers select AES-NI / ARMv8 Crypto Extensions at runtime,
+// the legacy AES_* block functions always run the generic code.
+class Cipher final {
+public:
+	Cipher(const EVP_CIPHER *type, const void *key, const void *iv, bool encrypt)
+	: _context(EVP_CIPHER_CTX_new()) {
+		EVP_CipherInit_ex(
+			_context,
+			type,
+			nullptr,
+			static_cast<const uchar*>(key),
+			static_cast<const uchar*>(iv),
+			encrypt ? 1 : 0);
+		EVP_CIPHER_CTX_set_padding(_context, 0);
+	}
+	Cipher(const Cipher &other) = delete;
+	Cipher &operator=(const Cipher &other) = delete;
+	~Cipher() {
+		EVP_CIPHER_CTX_free(_context);
+	}
+
+	void process(const uchar *src, uchar *dst, int len) {
+		auto written = 0;
+		EVP_CipherUpdate(_context, dst, &written, src, len);
+	}
+
+private:
+	EVP_CIPHER_CTX *_context = nullptr;
+
+};
+
+inline void XorBlock(uchar *to, const uchar *with) {
+	for (auto i = 0; i != kBlockSize; ++i) {
+		to[i] ^= with[i];
+	}
+}
+
+} // namespace
 
 AuthKey::AuthKey(Type type, DcId dcId, const Data &data)
 : _type(type)
@@ -149,41 +192,93 @@ void AuthKey::countKeyId() {
 }
 
 void aesIgeEncryptRaw(const void *src, void *dst, uint32 len, const void *key, const void *iv) {
-	uchar aes_key[32], aes_iv[32];
-	memcpy(aes_key, key, 32);
-	memcpy(aes_iv, iv, 32);
-
-	AES_KEY aes;
-	AES_set_encrypt_key(aes_key, 256, &aes);
-	AES_ige_encrypt(static_cast<const uchar*>(src), static_cast<uchar*>(dst), len, &aes, aes_iv, AES_ENCRYPT);
+	Expects(!(len % kBlockSize));
+
+	// IGE encryption y[i] = E(x[i] ^ y[i - 1]) ^ x[i - 1] is computed as
+	// CBC over p[i] = x[i] ^ x[i - 2] in a single call, y[i] = c[i] ^ x[i - 1].
+	const auto from = static_cast<const uchar*>(src);
+	const auto to = static_cast<uchar*>(dst);
+	const auto ivBytes = static_cast<const uchar*>(iv);
+	auto buffer = std::vector<uchar>(from, from + len);
+	for (auto i = int(len) - kBlockSize; i >= 2 * kBlockSize; i -= kBlockSize) {
+		XorBlock(buffer.data() + i, from + i - 2 * kBlockSize);
+	}
+	if (len > kBlockSize) {
+		XorBlock(buffer.data() + kBlockSize, ivBytes + kBlockSize);
+	}
+	Cipher(EVP_aes_256_cbc(), key, ivBytes, true).process(
+		buffer.data(),
+		buffer.data(),
+		len);
+
+	// Backwards, so that src == dst still has x[i - 1] when we need it.
+	for (auto i = int(len) - kBlockSize; i >= 0; i -= kBlockSize) {
+		const auto previous = i
+			? (from + i - kBlockSize)
+			: (ivBytes + kBlockSize);
+		XorBlock(buffer.data() + i, previous);
+		memcpy(to + i, buffer.data() + i, kBlockSize);
+	}
 }
 
 void aesIgeDecryptRaw(const void *src, void *dst, uint32 len, const void *key, const void *iv) {
-	uchar aes_key[32], aes_iv[32];
-	memcpy(aes_key, key, 32);
-	memcpy(aes_iv, iv, 32);
-
-	AES_KEY aes;
-	AES_set_decrypt_key(aes_key, 256, &aes);
-	AES_ige_encrypt(static_cast<const uchar*>(src), static_cast<uchar*>(dst), len, &aes, aes_iv, AES_DECRYPT);
+	Expects(!(len % kBlockSize));
+
+	// Decryption chains through the plain text, so it goes block by block.
+	const auto from = static_cast<const uchar*>(src);
+	const auto to = static_cast<uchar*>(dst);
+	uchar y[kBlockSize], x[kBlockSize], block[kBlockSize];
+	memcpy(y, iv, kBlockSize);
+	memcpy(x, static_cast<const uchar*>(iv) + kBlockSize, kBlockSize);
+	auto cipher = Cipher(EVP_aes_256_ecb(), key, nullptr, false);
+	for (auto i = 0; i < int(len); i += kBlockSize) {
+		memcpy(block, from + i, kBlockSize);
+		XorBlock(block, x);
+		cipher.process(block, block, kBlockSize);
+		XorBlock(block, y);
+		memcpy(y, from + i, kBlockSize);
+		memcpy(x, block, kBlockSize);
+		memcpy(to + i, block, kBlockSize);
+	}
 }
 
 void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state) {
-	AES_KEY aes;
-	AES_set_encrypt_key(static_cast<const uchar*>(key), 256, &aes);
-
-	static_assert(CTRState::IvecSize == AES_BLOCK_SIZE, "Wrong size of ctr ivec!");
-	static_assert(CTRState::EcountSize == AES_BLOCK_SIZE, "Wrong size of ctr ecount!");
-
-	CRYPTO_ctr128_encrypt(
-		reinterpret_cast<const uchar*>(data.data()),
-		reinterpret_cast<uchar*>(data.data()),
-		data.size(),
-		&aes,
-		state->ivec,
-		state->ecount,
-		&state->num,
-		(block128_f)AES_encrypt);
+	static_assert(CTRState::IvecSize == kBlockSize, "Wrong size of ctr ivec!");
+	static_assert(CTRState::EcountSize == kBlockSize, "Wrong size of ctr ecount!");
+
+	auto bytes = reinterpret_cast<uchar*>(data.data());
+	auto size = int(data.size());
+
+	// Use what is left from the previous block's key stream.
+	for (; state->num && size; --size) {
+		*bytes++ ^= state->ecount[state->num];
+		state->num = (state->num + 1) % kBlockSize;
+	}
+	if (!size) {
+		return;
+	}
+	auto cipher = Cipher(EVP_aes_256_ctr(), key, state->ivec, true);
+	const auto full = size - (size % kBlockSize);
+	cipher.process(bytes, bytes, full);
+
+	const auto tail = size - full;
+	if (tail) {
+		memset(state->ecount, 0, kBlockSize);
+		cipher.process(state->ecount, state->ecount, kBlockSize);
+		for (auto i = 0; i != tail; ++i) {
+			bytes[full + i] ^= state->ecount[i];
+		}
+		state->num = tail;
+	}
+
+	// Advance the big endian counter by the blocks used.
+	auto add = uint64((full / kBlockSize) + (tail ? 1 : 0));
+	for (auto i = kBlockSize; i != 0 && add;) {
+		--i;
+		add += state->ivec[i];
+		state->ivec[i] = uchar(add & 0xFF);
+		add >>= 8;
+	}
 }
 
 } // namespace MTP
@@ -182,7 +182,8 @@ void ConcurrentSender::senderRequestCancel(mtpRequestId requestId) {
 }
 
 void ConcurrentSender::senderRequestCancelAll() {
-	auto list = std::vector<mtpRequestId>(_requests.size());
+	auto list = std::vector<mtpRequestId>();
+	list.reserve(_requests.size());
 	for (const auto &pair : base::take(_requests)) {
 		list.push_back(pair.first);
 	}
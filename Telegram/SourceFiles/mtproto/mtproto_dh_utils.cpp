@@ -9,10 +9,40 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/openssl_help.h"
 
+#include <QtCore/QMutex>
+
 namespace MTP {
 namespace {
 
 constexpr auto kMaxModExpSize = 256;
+constexpr auto kMaxCheckedPrimes = 8;
+
+struct CheckedPrime {
+	bytes::vector prime;
+	int g = 0;
+};
+
+QMutex CheckedPrimesMutex;
+std::vector<CheckedPrime> CheckedPrimes;
+
+[[nodiscard]] bool IsCheckedPrime(bytes::const_span primeBytes, int g) {
+	QMutexLocker lock(&CheckedPrimesMutex);
+	for (const auto &checked : CheckedPrimes) {
+		if (checked.g == g
+			&& !bytes::compare(bytes::make_span(checked.prime), primeBytes)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void RememberCheckedPrime(bytes::const_span primeBytes, int g) {
+	QMutexLocker lock(&CheckedPrimesMutex);
+	if (CheckedPrimes.size() == kMaxCheckedPrimes) {
+		CheckedPrimes.erase(begin(CheckedPrimes));
+	}
+	CheckedPrimes.push_back({ bytes::make_vector(primeBytes), g });
+}
 
 bool IsPrimeAndGoodCheck(const openssl::BigNum &prime, int g) {
 	constexpr auto kGoodPrimeBitsCount = 2048;
@@ -127,7 +157,14 @@ bool IsPrimeAndGood(bytes::const_span primeBytes, int g) {
 		}
 	}
 
-	return IsPrimeAndGoodCheck(openssl::BigNum(primeBytes), g);
+	// The full primality check is slow, servers reuse the same primes.
+	if (IsCheckedPrime(primeBytes, g)) {
+		return true;
+	} else if (!IsPrimeAndGoodCheck(openssl::BigNum(primeBytes), g)) {
+		return false;
+	}
+	RememberCheckedPrime(primeBytes, g);
+	return true;
 }
 
 ModExpFirst CreateModExp(
@@ -435,9 +435,25 @@ void Session::sendPrepared(
 
 	DEBUG_LOG(("MTP Info: added, requestId %1").arg(request->requestId));
 	if (msCanWait >= 0) {
-		InvokeQueued(this, [=] {
-			sendAnything(msCanWait);
-		});
+		queueSendAnything(msCanWait);
+	}
+}
+
+void Session::queueSendAnything(crl::time msCanWait) {
+	Expects(msCanWait >= 0);
+
+	// Requests added in one go are flushed by a single sendAnything,
+	// so they end up in one container instead of separate writes.
+	auto queued = _queuedSendWait.load();
+	while (queued < 0 || queued > msCanWait) {
+		if (_queuedSendWait.compare_exchange_weak(queued, msCanWait)) {
+			if (queued < 0) {
+				InvokeQueued(this, [=] {
+					sendAnything(_queuedSendWait.exchange(-1));
+				});
+			}
+			break;
+		}
 	}
 }
 
@@ -192,6 +192,7 @@ private:
 	[[nodiscard]] bool releaseGenericKeyCreationOnDone(
 		const AuthKeyPtr &temporaryKey,
 		const AuthKeyPtr &persistentKeyUsedForBind);
+	void queueSendAnything(crl::time msCanWait);
 
 	const not_null<Instance*> _instance;
 	const ShiftedDcId _shiftedDcId = 0;
@@ -209,6 +210,7 @@ private:
 
 	crl::time _msSendCall = 0;
 	crl::time _msWait = 0;
+	std::atomic<crl::time> _queuedSendWait = -1;
 
 	bool _ping = false;
 
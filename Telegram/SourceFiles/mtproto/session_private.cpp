@@ -190,6 +190,8 @@ void SessionPrivate::appendTestConnection(
 	const auto priority = (qthelp::is_ipv6(ip) ? 0 : 1)
 		+ (protocol == DcOptions::Variants::Tcp ? 1 : 0)
 		+ (protocolSecret.empty() ? 0 : 1);
+	const auto endpoint = QString::number(int(protocol))
+		+ '/' + ip + ':' + QString::number(port);
 	_testConnections.push_back({
 		AbstractConnection::Create(
 			_instance,
@@ -197,6 +199,7 @@ void SessionPrivate::appendTestConnection(
 			thread(),
 			protocolSecret,
 			_options->proxy),
+		endpoint,
 		priority
 	});
 	const auto weak = _testConnections.back().data.get();
@@ -785,6 +788,10 @@ void SessionPrivate::tryToSend() {
 			if (toSendRequest->requestId) {
 				if (toSendRequest.needAck()) {
 					toSendRequest->lastSentTime = crl::now();
+					if (!toSendRequest->firstSentTime) {
+						toSendRequest->firstSentTime
+							= toSendRequest->lastSentTime;
+					}
 
 					QWriteLocker locker2(_sessionData->haveSentMutex());
 					auto &haveSent = _sessionData->haveSentMap();
@@ -894,6 +901,9 @@ void SessionPrivate::tryToSend() {
 				if (request->requestId) {
 					if (request.needAck()) {
 						request->lastSentTime = crl::now();
+						if (!request->firstSentTime) {
+							request->firstSentTime = request->lastSentTime;
+						}
 						int32 reqNeedsLayer = (needsLayer && request->needsLayer) ? toSendRequest->size() : 0;
 						if (request->after) {
 							WrapInvokeAfter(toSendRequest, request, haveSent, reqNeedsLayer ? initSizeInInts : 0);
@@ -1396,7 +1406,6 @@ void SessionPrivate::handleReceived() {
 		} else if (registered == ReceivedIdsManager::Result::TooOld) {
 			res = HandleResult::ResetSession;
 		}
-		_receivedMessageIds.shrink();
 
 		// send acks
 		if (const auto toAckSize = _ackRequestData.size()) {
@@ -2315,7 +2324,18 @@ void SessionPrivate::onConnected(
 	const auto j = ranges::find_if(
 		_testConnections,
 		[&](const TestConnection &test) { return test.priority > my; });
-	if (j != end(_testConnections)) {
+
+	// Don't wait for a better one if this one worked for us last time.
+	const auto known = !_lastChosenEndpoint.isEmpty()
+		&& (i->endpoint == _lastChosenEndpoint);
+	if (known) {
+		DEBUG_LOG(("MTP Info: connection %1 succeed, it was chosen before."
+			).arg(i->data->tag()));
+		_waitForBetterTimer.cancel();
+		_connection = std::move(i->data);
+		_testConnections.clear();
+		checkAuthKey();
+	} else if (j != end(_testConnections)) {
 		DEBUG_LOG(("MTP Info: connection %1 succeed, waiting for %2.").arg(
 			i->data->tag(),
 			j->data->tag()));
@@ -2323,6 +2343,7 @@ void SessionPrivate::onConnected(
 	} else {
 		DEBUG_LOG(("MTP Info: connection through IPv4 succeed."));
 		_waitForBetterTimer.cancel();
+		_lastChosenEndpoint = i->endpoint;
 		_connection = std::move(i->data);
 		_testConnections.clear();
 		checkAuthKey();
@@ -2359,6 +2380,7 @@ void SessionPrivate::confirmBestConnection() {
 	DEBUG_LOG(("MTP Info: can't connect through better, using %1."
 		).arg(i->data->tag()));
 
+	_lastChosenEndpoint = i->endpoint;
 	_connection = std::move(i->data);
 	_testConnections.clear();
 
@@ -2367,6 +2389,13 @@ void SessionPrivate::confirmBestConnection() {
 
 void SessionPrivate::removeTestConnection(
 		not_null<AbstractConnection*> connection) {
+	const auto i = ranges::find(
+		_testConnections,
+		connection.get(),
+		[](const TestConnection &test) { return test.data.get(); });
+	if (i != end(_testConnections) && i->endpoint == _lastChosenEndpoint) {
+		_lastChosenEndpoint = QString();
+	}
 	_testConnections.erase(
 		ranges::remove(
 			_testConnections,
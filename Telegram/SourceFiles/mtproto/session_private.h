@@ -14,6 +14,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/connection_abstract.h"
 #include "mtproto/facade.h"
 #include "base/timer.h"
+#include "base/flat_map.h"
+#include "base/flat_set.h"
 
 namespace MTP {
 namespace details {
@@ -55,6 +57,7 @@ private:
 
 	struct TestConnection {
 		ConnectionPointer data;
+		QString endpoint;
 		int priority = 0;
 	};
 	struct SentContainer {
@@ -192,6 +195,7 @@ private:
 
 	ConnectionPointer _connection;
 	std::vector<TestConnection> _testConnections;
+	QString _lastChosenEndpoint;
 	crl::time _startedConnectingAt = 0;
 
 	base::Timer _retryTimer; // exp retry timer
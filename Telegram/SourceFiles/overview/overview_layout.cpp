@@ -472,6 +472,12 @@ void Photo::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Photo::preload() const {
+	if (!_goodLoaded) {
+		ensureDataMediaCreated();
+	}
+}
+
 TextState Photo::getState(
 		QPoint point,
 		StateRequest request) const {
@@ -657,6 +663,10 @@ void Video::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Video::preload() const {
+	ensureDataMediaCreated();
+}
+
 float64 Video::dataProgress() const {
 	ensureDataMediaCreated();
 	return _dataMedia->progress();
@@ -2233,6 +2243,10 @@ void Gif::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Gif::preload() const {
+	ensureDataMediaCreated();
+}
+
 void Gif::setPosition(int32 position) {
 	AbstractLayoutItem::setPosition(position);
 	if (position < 0) {
@@ -76,6 +76,10 @@ public:
 	virtual void clearHeavyPart() {
 	}
 
+	// Requests the thumbnails before the item is shown.
+	virtual void preload() const {
+	}
+
 protected:
 	[[nodiscard]] not_null<HistoryItem*> parent() const {
 		return _parent;
@@ -209,6 +213,7 @@ public:
 
 	void itemDataChanged() override;
 	void clearHeavyPart() override;
+	void preload() const override;
 
 private:
 	void ensureDataMediaCreated() const;
@@ -247,6 +252,7 @@ public:
 		StateRequest request) const override;
 
 	void clearHeavyPart() override;
+	void preload() const override;
 	void setPosition(int32 position) override;
 
 protected:
@@ -304,6 +310,7 @@ public:
 	void itemDataChanged() override;
 	void clearHeavyPart() override;
 	void clearSpoiler() override;
+	void preload() const override;
 
 protected:
 	float64 dataProgress() const override;
@@ -39,6 +39,7 @@ namespace GObject = gi::repository::GObject;
 
 constexpr auto kService = "org.freedesktop.Notifications";
 constexpr auto kObjectPath = "/org/freedesktop/Notifications";
+constexpr auto kMaxCachedUserpics = 64;
 
 struct ServerInformation {
 	std::string name;
@@ -574,11 +575,21 @@ public:
 	~Private();
 
 private:
+	struct CachedUserpic {
+		InMemoryKey key;
+		QImage image;
+	};
+
+	[[nodiscard]] QImage userpic(
+		not_null<PeerData*> peer,
+		Ui::PeerUserpicView &userpicView);
+
 	const not_null<Manager*> _manager;
 
 	base::flat_map<
 		ContextId,
 		base::flat_map<MsgId, Notification>> _notifications;
+	base::flat_map<std::pair<uint64, PeerId>, CachedUserpic> _userpics;
 
 	XdgNotifications::NotificationsProxy _proxy;
 	XdgNotifications::Notifications _interface;
@@ -809,8 +820,7 @@ void Manager::Private::showNotification(
 	}
 
 	if (!options.hideNameAndPhoto) {
-		notification->setImage(
-			Window::Notifications::GenerateUserpic(peer, userpicView));
+		notification->setImage(userpic(peer, userpicView));
 	}
 
 	auto i = _notifications.find(key);
@@ -834,6 +844,22 @@ void Manager::Private::showNotification(
 	j->second->show();
 }
 
+QImage Manager::Private::userpic(
+		not_null<PeerData*> peer,
+		Ui::PeerUserpicView &userpicView) {
+	const auto key = peer->userpicUniqueKey(userpicView);
+	const auto id = std::make_pair(peer->session().uniqueId(), peer->id);
+	const auto i = _userpics.find(id);
+	if (i != end(_userpics) && i->second.key == key) {
+		return i->second.image;
+	} else if (_userpics.size() >= kMaxCachedUserpics) {
+		_userpics.clear();
+	}
+	auto image = Window::Notifications::GenerateUserpic(peer, userpicView);
+	_userpics[id] = CachedUserpic{ key, image };
+	return image;
+}
+
 void Manager::Private::clearAll() {
 	for (const auto &[key, notifications] : base::take(_notifications)) {
 		for (const auto &[msgId, notification] : notifications) {
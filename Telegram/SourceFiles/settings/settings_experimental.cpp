@@ -18,11 +18,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/options.h"
 #include "core/application.h"
 #include "core/launcher.h"
+#include "core/power_saving_governor.h"
+#include "core/stall_detector.h"
 #include "chat_helpers/tabbed_panel.h"
 #include "dialogs/dialogs_widget.h"
 #include "info/profile/info_profile_actions.h"
 #include "lang/lang_keys.h"
 #include "mainwindow.h"
+#include "media/audio/media_audio_track.h"
 #include "media/player/media_player_instance.h"
 #include "webview/webview_embed.h"
 #include "window/main_window.h"
@@ -31,7 +34,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/window_controller.h"
 #include "window/notifications_manager.h"
 #include "storage/localimageloader.h"
+#include "storage/download_manager_mtproto.h"
 #include "data/data_document_resolver.h"
+#include "data/data_history_cache.h"
+#include "data/data_search_index.h"
 #include "styles/style_settings.h"
 #include "styles/style_layers.h"
 
@@ -148,12 +154,18 @@ void SetupExperimental(
 	addToggle(Ui::GL::kOptionAllowLinuxNvidiaOpenGL);
 	addToggle(Ui::kOptionUseSmallMsgBubbleRadius);
 	addToggle(Media::Player::kOptionDisableAutoplayNext);
+	addToggle(Media::Audio::kOptionLowLatencyAudio);
 	addToggle(kOptionSendLargePhotos);
+	addToggle(Storage::kOptionAdaptiveDownloads);
 	addToggle(Webview::kOptionWebviewDebugEnabled);
 	addToggle(kOptionAutoScrollInactiveChat);
 	addToggle(Window::Notifications::kOptionGNotification);
 	addToggle(Core::kOptionFreeType);
+	addToggle(Core::kOptionAdaptivePowerSaving);
+	addToggle(Core::kOptionStallDetector);
 	addToggle(Data::kOptionExternalVideoPlayer);
+	addToggle(Data::kOptionLocalHistoryCache);
+	addToggle(Data::kOptionLocalMessagesSearch);
 	addToggle(Window::kOptionNewWindowsSizeAsFirst);
 }
 
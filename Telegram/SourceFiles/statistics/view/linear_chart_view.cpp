@@ -35,6 +35,30 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
+	// Points falling into one pixel column are reduced to the first, the
+	// lowest, the highest and the last ones, so that long ranges don't
+	// draw every single point.
+	auto column = std::numeric_limits<int>::min();
+	auto first = QPointF();
+	auto last = QPointF();
+	auto top = QPointF();
+	auto bottom = QPointF();
+	auto inColumn = 0;
+	const auto flushColumn = [&] {
+		if (!inColumn) {
+			return;
+		}
+		chartPoints << first;
+		if (inColumn > 1) {
+			if (top.x() < bottom.x()) {
+				chartPoints << top << bottom;
+			} else {
+				chartPoints << bottom << top;
+			}
+			chartPoints << last;
+		}
+	};
+
 	for (auto i = localStart; i <= localEnd; i++) {
 		if (line.y[i] < 0) {
 			continue;
@@ -45,8 +69,24 @@ void PaintChartLine(
 		const auto yPercentage = (line.y[i] * ratio - c.heightLimits.min)
 			/ float64(c.heightLimits.max - c.heightLimits.min);
 		const auto yPoint = (1. - yPercentage) * c.rect.height();
-		chartPoints << QPointF(xPoint, yPoint);
+		const auto point = QPointF(xPoint, yPoint);
+		const auto pointColumn = int(std::floor(xPoint));
+		if (pointColumn != column) {
+			flushColumn();
+			column = pointColumn;
+			first = last = top = bottom = point;
+			inColumn = 1;
+			continue;
+		}
+		last = point;
+		if (yPoint < top.y()) {
+			top = point;
+		} else if (yPoint > bottom.y()) {
+			bottom = point;
+		}
+		++inColumn;
 	}
+	flushColumn();
 	p.setPen(QPen(
 		line.color,
 		c.footer ? st::lineWidth : st::statisticsChartLineWidth));
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <crl/crl_object_on_thread.h>
 #include <QtCore/QtEndian>
 #include <QtCore/QSaveFile>
+#include <QtCore/QWaitCondition>
 
 namespace Storage {
 namespace details {
@@ -236,6 +237,76 @@ void AsyncWriteManager::stop() {
 
 AsyncWriteManager Manager;
 
+// Plain contents hash of the last write scheduled for each file.
+QMutex LastWrittenMutex;
+base::flat_map<QString, QByteArray> LastWritten;
+
+[[nodiscard]] bool RememberWritten(const QString &base, QByteArray hash) {
+	QMutexLocker lock(&LastWrittenMutex);
+	auto &already = LastWritten[base];
+	if (already == hash && QFileInfo::exists(base + 's')) {
+		return false;
+	}
+	already = std::move(hash);
+	return true;
+}
+
+void ForgetWritten(const QString &base) {
+	QMutexLocker lock(&LastWrittenMutex);
+	LastWritten.remove(base);
+}
+
+struct PrefetchedFile {
+	MTP::AuthKeyPtr key;
+	QMutex mutex;
+	QWaitCondition finished;
+	bool done = false;
+	bool success = false;
+	int32 version = 0;
+	QByteArray data;
+	qint64 position = 0;
+};
+
+// Files read ahead on the thread pool, taken by the first ReadFile().
+QMutex PrefetchedMutex;
+base::flat_map<QString, std::shared_ptr<PrefetchedFile>> Prefetched;
+
+[[nodiscard]] std::shared_ptr<PrefetchedFile> TakePrefetched(
+		const QString &base,
+		const MTP::AuthKeyPtr &key) {
+	QMutexLocker lock(&PrefetchedMutex);
+	const auto i = Prefetched.find(base);
+	if (i == end(Prefetched)) {
+		return nullptr;
+	}
+	auto result = std::move(i->second);
+	Prefetched.erase(i);
+	return (result->key == key) ? result : nullptr;
+}
+
+void ForgetPrefetched(const QString &base) {
+	QMutexLocker lock(&PrefetchedMutex);
+	Prefetched.remove(base);
+}
+
+[[nodiscard]] QByteArray EncryptPrepared(
+		QByteArray &toEncrypt,
+		const MTP::AuthKeyPtr &key) {
+	// prepare for encryption
+	uint32 size = toEncrypt.size(), fullSize = size;
+	if (fullSize & 0x0F) {
+		fullSize += 0x10 - (fullSize & 0x0F);
+		toEncrypt.resize(fullSize);
+		base::RandomFill(toEncrypt.data() + size, fullSize - size);
+	}
+	*(uint32*)toEncrypt.data() = size;
+	QByteArray encrypted(0x10 + fullSize, Qt::Uninitialized); // 128bit of sha1 - key128, sizeof(data), data
+	hashSha1(toEncrypt.constData(), toEncrypt.size(), encrypted.data());
+	MTP::aesEncryptLocal(toEncrypt.constData(), encrypted.data() + 0x10, fullSize, key, encrypted.constData());
+
+	return encrypted;
+}
+
 } // namespace
 
 QString ToFilePart(FileKey val) {
@@ -282,7 +353,10 @@ FileKey GenerateKey(const QString &basePath) {
 void ClearKey(const FileKey &key, const QString &basePath) {
 	QString name;
 	name.reserve(basePath.size() + 0x11);
-	name.append(basePath).append(ToFilePart(key)).append('0');
+	name.append(basePath).append(ToFilePart(key));
+	ForgetWritten(name);
+	ForgetPrefetched(name);
+	name.append('0');
 	QFile::remove(name);
 	name[name.size() - 1] = '1';
 	QFile::remove(name);
@@ -398,6 +472,7 @@ FileWriteDescriptor::~FileWriteDescriptor() {
 
 void FileWriteDescriptor::init(const QString &name) {
 	_base = _basePath + name;
+	ForgetPrefetched(_base);
 	_buffer.setBuffer(&_safeData);
 	const auto opened = _buffer.open(QIODevice::WriteOnly);
 	Assert(opened);
@@ -408,6 +483,13 @@ void FileWriteDescriptor::writeData(const QByteArray &data) {
 	if (!_stream.device()) {
 		return;
 	}
+	_parts.push_back({ data });
+	const auto size = data.isNull() ? 0xffffffffU : quint32(data.size());
+	_plainMd5.feed(&size, sizeof(size));
+	_plainMd5.feed(data.constData(), data.size());
+}
+
+void FileWriteDescriptor::writePart(const QByteArray &data) {
 	_stream << data;
 	quint32 len = data.isNull() ? 0xffffffff : data.size();
 	if (QSysInfo::ByteOrder != QSysInfo::BigEndian) {
@@ -421,7 +503,18 @@ void FileWriteDescriptor::writeData(const QByteArray &data) {
 void FileWriteDescriptor::writeEncrypted(
 	EncryptedDescriptor &data,
 	const MTP::AuthKeyPtr &key) {
-	writeData(PrepareEncrypted(data, key));
+	Expects(key != nullptr);
+
+	if (!_stream.device()) {
+		return;
+	}
+	data.finish();
+	_parts.push_back({ data.data, key });
+	const auto keyId = key->keyId();
+	const auto size = quint32(data.data.size());
+	_plainMd5.feed(&keyId, sizeof(keyId));
+	_plainMd5.feed(&size, sizeof(size));
+	_plainMd5.feed(data.data.constData(), data.data.size());
 }
 
 void FileWriteDescriptor::finish() {
@@ -429,6 +522,21 @@ void FileWriteDescriptor::finish() {
 		return;
 	}
 
+	const auto hash = QByteArray(
+		reinterpret_cast<const char*>(_plainMd5.result()),
+		0x10);
+	if (!RememberWritten(_base, hash)) {
+		// Nothing changed since the last write, skip encryption and i/o.
+		_stream.setDevice(nullptr);
+		_buffer.close();
+		return;
+	}
+	for (auto &part : base::take(_parts)) {
+		writePart(part.key
+			? EncryptPrepared(part.data, part.key)
+			: part.data);
+	}
+
 	_stream.setDevice(nullptr);
 	_md5.feed(&_fullSize, sizeof(_fullSize));
 	qint32 version = AppVersion;
@@ -454,24 +562,12 @@ void FileWriteDescriptor::finish() {
 		EncryptedDescriptor &data,
 		const MTP::AuthKeyPtr &key) {
 	data.finish();
-	QByteArray &toEncrypt(data.data);
-
-	// prepare for encryption
-	uint32 size = toEncrypt.size(), fullSize = size;
-	if (fullSize & 0x0F) {
-		fullSize += 0x10 - (fullSize & 0x0F);
-		toEncrypt.resize(fullSize);
-		base::RandomFill(toEncrypt.data() + size, fullSize - size);
-	}
-	*(uint32*)toEncrypt.data() = size;
-	QByteArray encrypted(0x10 + fullSize, Qt::Uninitialized); // 128bit of sha1 - key128, sizeof(data), data
-	hashSha1(toEncrypt.constData(), toEncrypt.size(), encrypted.data());
-	MTP::aesEncryptLocal(toEncrypt.constData(), encrypted.data() + 0x10, fullSize, key, encrypted.constData());
-
-	return encrypted;
+	return EncryptPrepared(data.data, key);
 }
 
-bool ReadFile(
+namespace {
+
+bool ReadFileDirect(
 		FileReadDescriptor &result,
 		const QString &name,
 		const QString &basePath) {
@@ -582,6 +678,8 @@ bool ReadFile(
 	return false;
 }
 
+} // namespace
+
 bool DecryptLocal(
 		EncryptedDescriptor &result,
 		const QByteArray &encrypted,
@@ -621,12 +719,14 @@ bool DecryptLocal(
 	return true;
 }
 
-bool ReadEncryptedFile(
+namespace {
+
+bool ReadEncryptedFileDirect(
 		FileReadDescriptor &result,
 		const QString &name,
 		const QString &basePath,
 		const MTP::AuthKeyPtr &key) {
-	if (!ReadFile(result, name, basePath)) {
+	if (!ReadFileDirect(result, name, basePath)) {
 		return false;
 	}
 	QByteArray encrypted;
@@ -657,6 +757,91 @@ bool ReadEncryptedFile(
 	return true;
 }
 
+void Prefetch(
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key) {
+	auto prefetched = std::make_shared<PrefetchedFile>();
+	prefetched->key = key;
+	{
+		QMutexLocker lock(&PrefetchedMutex);
+		Prefetched[basePath + name] = prefetched;
+	}
+	crl::async([=] {
+		FileReadDescriptor descriptor;
+		const auto success = key
+			? ReadEncryptedFileDirect(descriptor, name, basePath, key)
+			: ReadFileDirect(descriptor, name, basePath);
+
+		QMutexLocker lock(&prefetched->mutex);
+		if (success) {
+			prefetched->version = descriptor.version;
+			prefetched->data = descriptor.data;
+			prefetched->position = descriptor.buffer.pos();
+		}
+		prefetched->success = success;
+		prefetched->done = true;
+		prefetched->finished.wakeAll();
+	});
+}
+
+[[nodiscard]] std::optional<bool> ReadPrefetched(
+		FileReadDescriptor &result,
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key) {
+	const auto prefetched = TakePrefetched(basePath + name, key);
+	if (!prefetched) {
+		return std::nullopt;
+	}
+	QMutexLocker lock(&prefetched->mutex);
+	while (!prefetched->done) {
+		prefetched->finished.wait(&prefetched->mutex);
+	}
+	if (!prefetched->success) {
+		return false;
+	}
+	result.version = prefetched->version;
+	result.data = base::take(prefetched->data);
+	result.buffer.setBuffer(&result.data);
+	result.buffer.open(QIODevice::ReadOnly);
+	result.buffer.seek(prefetched->position);
+	result.stream.setDevice(&result.buffer);
+	result.stream.setVersion(QDataStream::Qt_5_1);
+	return true;
+}
+
+} // namespace
+
+bool ReadFile(
+		FileReadDescriptor &result,
+		const QString &name,
+		const QString &basePath) {
+	if (const auto prefetched = ReadPrefetched(
+			result,
+			name,
+			basePath,
+			nullptr)) {
+		return *prefetched;
+	}
+	return ReadFileDirect(result, name, basePath);
+}
+
+bool ReadEncryptedFile(
+		FileReadDescriptor &result,
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key) {
+	if (const auto prefetched = ReadPrefetched(
+			result,
+			name,
+			basePath,
+			key)) {
+		return *prefetched;
+	}
+	return ReadEncryptedFileDirect(result, name, basePath, key);
+}
+
 bool ReadEncryptedFile(
 		FileReadDescriptor &result,
 		const FileKey &fkey,
@@ -665,6 +850,24 @@ bool ReadEncryptedFile(
 	return ReadEncryptedFile(result, ToFilePart(fkey), basePath, key);
 }
 
+void PrefetchFile(const QString &name, const QString &basePath) {
+	Prefetch(name, basePath, nullptr);
+}
+
+void PrefetchEncryptedFile(
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key) {
+	Expects(key != nullptr);
+
+	Prefetch(name, basePath, key);
+}
+
+void ClearPrefetched() {
+	QMutexLocker lock(&PrefetchedMutex);
+	Prefetched.clear();
+}
+
 void Sync() {
 	Manager.sync();
 }
@@ -70,8 +70,14 @@ public:
 		const MTP::AuthKeyPtr &key);
 
 private:
+	struct Part {
+		QByteArray data;
+		MTP::AuthKeyPtr key;
+	};
+
 	void init(const QString &name);
 	void finish();
+	void writePart(const QByteArray &data);
 
 	const QString _basePath;
 	QBuffer _buffer;
@@ -82,6 +88,10 @@ private:
 	int _fullSize = 0;
 	bool _sync = false;
 
+	// Encryption is postponed till we know that the contents changed.
+	std::vector<Part> _parts;
+	HashMd5 _plainMd5;
+
 };
 
 bool ReadFile(
@@ -106,6 +116,15 @@ bool ReadEncryptedFile(
 	const QString &basePath,
 	const MTP::AuthKeyPtr &key);
 
+// Reads (and decrypts) the file on the thread pool in advance,
+// the next ReadFile() / ReadEncryptedFile() of it takes the result.
+void PrefetchFile(const QString &name, const QString &basePath);
+void PrefetchEncryptedFile(
+	const QString &name,
+	const QString &basePath,
+	const MTP::AuthKeyPtr &key);
+void ClearPrefetched();
+
 void Sync();
 void Finish();
 
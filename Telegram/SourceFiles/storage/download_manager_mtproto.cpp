@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "storage/download_manager_mtproto.h"
 
+#include "core/tracing.h"
 #include "mtproto/facade.h"
 #include "mtproto/mtproto_auth_key.h"
 #include "mtproto/mtproto_response.h"
@@ -15,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document.h"
 #include "apiwrap.h"
 #include "base/openssl_help.h"
+#include "base/options.h"
 
 namespace Storage {
 namespace {
@@ -32,14 +34,30 @@ constexpr auto kMaxTrackedSuccesses = kRetryAddSessionSuccesses
 constexpr auto kRemoveSessionAfterTimeouts = 4;
 constexpr auto kResetDownloadPrioritiesTimeout = crl::time(200);
 constexpr auto kBadRequestDurationThreshold = 8 * crl::time(1000);
+constexpr auto kMaxWaitedInSessionAdaptive = 64 * kDownloadPartSize;
+constexpr auto kAdaptiveRequestsInSession = 4;
+constexpr auto kAdaptiveBandwidthSmoothing = 8;
+constexpr auto kBulkStarvationTimeout = crl::time(1000);
+constexpr auto kInteractivePicksPerStarvingBulk = 4;
+constexpr auto kInteractiveReservedAmount = kDownloadPartSize;
+constexpr auto kInteractiveReserveMinWaited = 8 * kDownloadPartSize;
 
 // Each (session remove by timeouts) we wait for time:
 // kRetryAddSessionTimeout * max(removesCount, kMaxTrackedSessionRemoves)
 // and for successes in all remaining sessions:
 // kRetryAddSessionSuccesses * max(removesCount, kMaxTrackedSessionRemoves)
 
+base::options::toggle AdaptiveDownloads({
+	.id = kOptionAdaptiveDownloads,
+	.name = "Adaptive download window",
+	.description = "Request up to 1 MB per part and size the in-flight"
+		" window by the measured bandwidth and round-trip time.",
+});
+
 } // namespace
 
+const char kOptionAdaptiveDownloads[] = "adaptive-downloads";
+
 void DownloadManagerMtproto::Queue::enqueue(
 		not_null<Task*> task,
 		int priority) {
@@ -52,7 +70,11 @@ void DownloadManagerMtproto::Queue::enqueue(
 			(now->priority = priority);
 			return now;
 		}
-		_tasks.push_back({ task, priority });
+		_tasks.push_back({
+			.task = task,
+			.priority = priority,
+			.waitingSince = crl::now(),
+		});
 		return end(_tasks) - 1;
 	}();
 	const auto j = begin(_tasks) + position;
@@ -71,7 +93,8 @@ void DownloadManagerMtproto::Queue::resetGeneration() {
 	const auto from = ranges::find(_tasks, 0, &Enqueued::priority);
 	for (auto &task : ranges::make_subrange(from, end(_tasks))) {
 		if (task.priority) {
-			Assert(task.priority == -1);
+			Assert(task.priority == -1
+				|| task.priority == kDownloadPreloadPriority);
 			break;
 		}
 		task.priority = -1;
@@ -82,7 +105,14 @@ bool DownloadManagerMtproto::Queue::empty() const {
 	return _tasks.empty();
 }
 
-auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
+bool DownloadManagerMtproto::Queue::Interactive(const Enqueued &enqueued) {
+	return (enqueued.priority > 0) || enqueued.task->interactive();
+}
+
+auto DownloadManagerMtproto::Queue::nextTask(
+	bool onlyHighestPriority,
+	bool allowBulk,
+	crl::time now) const
 -> Task* {
 	if (_tasks.empty()) {
 		return nullptr;
@@ -94,13 +124,67 @@ auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
 	const auto till = (onlyHighestPriority && highestPriority > 0)
 		? ranges::find_if(_tasks, notHighestPriority)
 		: end(_tasks);
-	const auto readyToRequest = [&](const Enqueued &enqueued) {
-		return enqueued.task->readyToRequest();
+	const auto range = ranges::make_subrange(begin(_tasks), till);
+	const auto readyInteractive = [&](const Enqueued &enqueued) {
+		return Interactive(enqueued) && enqueued.task->readyToRequest();
 	};
-	const auto first = ranges::find_if(
-		ranges::make_subrange(begin(_tasks), till),
-		readyToRequest);
-	return (first != till) ? first->task.get() : nullptr;
+	const auto readyBulk = [&](const Enqueued &enqueued) {
+		return !Interactive(enqueued) && enqueued.task->readyToRequest();
+	};
+	auto starving = (const Enqueued*)nullptr;
+	if (allowBulk) {
+		for (const auto &enqueued : range) {
+			if (enqueued.priority > kDownloadPreloadPriority
+				&& enqueued.waitingSince + kBulkStarvationTimeout <= now
+				&& (!starving
+					|| enqueued.waitingSince < starving->waitingSince)
+				&& readyBulk(enqueued)) {
+				starving = &enqueued;
+			}
+		}
+	}
+	// A starving bulk task gets one pick after a few interactive ones,
+	// so the interactive downloads still go first most of the time.
+	const auto first = ranges::find_if(range, readyInteractive);
+	if (starving
+		&& (first == till
+			|| _interactiveInRow >= kInteractivePicksPerStarvingBulk)) {
+		return starving->task.get();
+	} else if (first != till) {
+		return first->task.get();
+	} else if (!allowBulk) {
+		return nullptr;
+	}
+
+	// Among the bulk tasks of the best ready priority choose the one
+	// with the smallest amount requested so far.
+	const auto bulk = ranges::find_if(range, readyBulk);
+	if (bulk == till) {
+		return nullptr;
+	}
+	auto fair = &*bulk;
+	for (const auto &enqueued : ranges::make_subrange(bulk + 1, till)) {
+		if (enqueued.priority != bulk->priority) {
+			break;
+		} else if (enqueued.served < fair->served && readyBulk(enqueued)) {
+			fair = &enqueued;
+		}
+	}
+	return fair->task.get();
+}
+
+void DownloadManagerMtproto::Queue::served(
+		not_null<Task*> task,
+		int amount,
+		crl::time now) {
+	const auto i = ranges::find(_tasks, task, &Enqueued::task);
+	if (i != end(_tasks)) {
+		i->served += amount;
+		i->waitingSince = now;
+		_interactiveInRow = Interactive(*i)
+			? std::min(_interactiveInRow + 1, kInteractivePicksPerStarvingBulk)
+			: 0;
+	}
 }
 
 void DownloadManagerMtproto::Queue::removeSession(int index) {
@@ -180,14 +264,21 @@ void DownloadManagerMtproto::checkSendNextAfterSuccess(MTP::DcId dcId) {
 bool DownloadManagerMtproto::trySendNextPart(MTP::DcId dcId, Queue &queue) {
 	auto &balanceData = _balanceData[dcId];
 	const auto &sessions = balanceData.sessions;
+	auto allowBulk = true;
 	const auto bestIndex = [&] {
 		const auto proj = [](const DcSessionBalanceData &data) {
 			return (data.requested < data.maxWaitedAmount)
 				? data.requested
-				: kMaxWaitedInSession;
+				: kMaxWaitedInSessionAdaptive;
 		};
 		const auto j = ranges::min_element(sessions, ranges::less(), proj);
-		return (j->requested + kDownloadPartSize <= j->maxWaitedAmount)
+		const auto after = j->requested + kDownloadPartSize;
+
+		// Leave room in large windows so that interactive requests
+		// don't have to wait for bulk parts to be received first.
+		allowBulk = (j->maxWaitedAmount < kInteractiveReserveMinWaited)
+			|| (after + kInteractiveReservedAmount <= j->maxWaitedAmount);
+		return (after <= j->maxWaitedAmount)
 			? (j - begin(sessions))
 			: -1;
 	}();
@@ -195,11 +286,15 @@ bool DownloadManagerMtproto::trySendNextPart(MTP::DcId dcId, Queue &queue) {
 		return false;
 	}
 	const auto onlyHighestPriority = (balanceData.totalRequested > 0);
-	if (const auto task = queue.nextTask(onlyHighestPriority)) {
-		task->loadPart(bestIndex);
-		return true;
+	const auto now = crl::now();
+	const auto task = queue.nextTask(onlyHighestPriority, allowBulk, now);
+	if (!task) {
+		return false;
 	}
-	return false;
+	const auto requestedBefore = balanceData.totalRequested;
+	task->loadPart(bestIndex);
+	queue.served(task, balanceData.totalRequested - requestedBefore, now);
+	return true;
 }
 
 int DownloadManagerMtproto::changeRequestedAmount(
@@ -259,7 +354,14 @@ void DownloadManagerMtproto::requestSucceeded(
 		});
 		return;
 	}
-	if (amountAtRequestStart == data.maxWaitedAmount
+	if (AdaptiveDownloads.value()) {
+		updateAdaptiveWindow(
+			dcId,
+			index,
+			data,
+			amountAtRequestStart,
+			duration);
+	} else if (amountAtRequestStart == data.maxWaitedAmount
 		&& data.maxWaitedAmount < kMaxWaitedInSession) {
 		data.maxWaitedAmount = std::min(
 			data.maxWaitedAmount + kDownloadPartSize,
@@ -291,11 +393,101 @@ void DownloadManagerMtproto::requestSucceeded(
 	if (dc.lastSessionRemove && now < dc.lastSessionRemove + delay) {
 		return;
 	}
+	if (dc.warmIndex == int(dc.sessions.size())) {
+		dc.warmIndex = -1;
+	}
 	dc.sessions.emplace_back();
 	DEBUG_LOG(("Download (%1,%2) adding, now sessions: %3"
 		).arg(dcId
 		).arg(dc.sessions.size() - 1
 		).arg(dc.sessions.size()));
+	warmUpNextSession(dcId, dc);
+}
+
+void DownloadManagerMtproto::warmUpNextSession(
+		MTP::DcId dcId,
+		DcBalanceData &dc) {
+	const auto index = int(dc.sessions.size());
+	if (index >= kMaxSessionsCount || dc.warmIndex == index) {
+		return;
+	}
+	stopWarmSession(dcId, dc);
+
+	// The temporary key is shared by all sessions of a dc, so what is left
+	// for a new session is the connection, let it be ready when needed.
+	DEBUG_LOG(("Download (%1,%2) warming up.").arg(dcId).arg(index));
+	dc.warmIndex = index;
+	api().instance().sendAnything(MTP::downloadDcId(dcId, index));
+}
+
+void DownloadManagerMtproto::stopWarmSession(
+		MTP::DcId dcId,
+		DcBalanceData &dc) {
+	if (dc.warmIndex >= 0) {
+		api().instance().stopSession(
+			MTP::downloadDcId(dcId, std::exchange(dc.warmIndex, -1)));
+	}
+}
+
+void DownloadManagerMtproto::updateAdaptiveWindow(
+		MTP::DcId dcId,
+		int index,
+		DcSessionBalanceData &data,
+		int amountAtRequestStart,
+		crl::time duration) {
+	if (amountAtRequestStart * 2 < data.maxWaitedAmount) {
+		// The window was mostly idle, this sample says nothing about
+		// the link capacity, only about how much we had to request.
+		return;
+	}
+
+	// Everything that was in flight when the request was sent
+	// has been delivered by now, so amount / duration approximates
+	// the session throughput and the shortest duration - its RTT.
+	const auto ms = std::max(duration, crl::time(1));
+	data.minDuration = data.minDuration
+		? std::min(data.minDuration, ms)
+		: ms;
+	const auto sample = int64(amountAtRequestStart) * 1000 / ms;
+	data.bandwidth = data.bandwidth
+		? ((data.bandwidth * (kAdaptiveBandwidthSmoothing - 1) + sample)
+			/ kAdaptiveBandwidthSmoothing)
+		: sample;
+
+	// Keep twice the bandwidth-delay product in flight.
+	const auto bdp = data.bandwidth * data.minDuration / 1000;
+	const auto parts = (2 * bdp + kDownloadPartSize - 1) / kDownloadPartSize;
+	const auto window = int(std::clamp(
+		parts * kDownloadPartSize,
+		int64(kStartWaitedInSession),
+		int64(kMaxWaitedInSessionAdaptive)));
+	if (data.maxWaitedAmount != window) {
+		data.maxWaitedAmount = window;
+		DEBUG_LOG(("Download (%1,%2) adaptive window %3, "
+			"bandwidth: %4, rtt: %5."
+			).arg(dcId
+			).arg(index
+			).arg(data.maxWaitedAmount
+			).arg(data.bandwidth
+			).arg(data.minDuration));
+	}
+}
+
+int DownloadManagerMtproto::chooseRequestPartsLimit(
+		MTP::DcId dcId,
+		int index) const {
+	if (!AdaptiveDownloads.value()) {
+		return 1;
+	}
+	const auto i = _balanceData.find(dcId);
+	Assert(i != end(_balanceData));
+	Assert(index < i->second.sessions.size());
+	const auto &data = i->second.sessions[index];
+	const auto free = (data.maxWaitedAmount - data.requested)
+		/ kDownloadPartSize;
+	const auto target = data.maxWaitedAmount
+		/ (kAdaptiveRequestsInSession * kDownloadPartSize);
+	return std::clamp(std::min(free, target), 1, kMaxPartsInRequest);
 }
 
 int DownloadManagerMtproto::chooseSessionIndex(MTP::DcId dcId) const {
@@ -322,6 +514,13 @@ void DownloadManagerMtproto::sessionTimedOut(MTP::DcId dcId, int index) {
 	for (auto &session : dc.sessions) {
 		session.successes = 0;
 	}
+	if (AdaptiveDownloads.value()) {
+		auto &session = dc.sessions[index];
+		session.maxWaitedAmount = std::max(
+			session.maxWaitedAmount / 2,
+			kStartWaitedInSession);
+		session.bandwidth /= 2;
+	}
 	if (dc.sessions.size() == kStartSessionsCount
 		|| ++dc.timeouts < kRemoveSessionAfterTimeouts) {
 		return;
@@ -347,6 +546,7 @@ void DownloadManagerMtproto::removeSession(MTP::DcId dcId) {
 		dc.sessionRemoveIndex = index;
 		dc.sessionRemoveTimes = 1;
 	}
+	stopWarmSession(dcId, dc);
 	auto &session = dc.sessions.back();
 
 	// Make sure we don't send anything to that session while redirecting.
@@ -400,6 +600,7 @@ void DownloadManagerMtproto::killSessions(MTP::DcId dcId) {
 	if (i != end(_balanceData)) {
 		auto &dc = i->second;
 		Assert(dc.totalRequested == 0);
+		stopWarmSession(dcId, dc);
 		auto sessions = base::take(dc.sessions);
 		dc = DcBalanceData();
 		for (auto j = 0; j != int(sessions.size()); ++j) {
@@ -476,19 +677,59 @@ void DownloadMtprotoTask::refreshFileReferenceFrom(
 }
 
 void DownloadMtprotoTask::loadPart(int sessionIndex) {
-	makeRequest({ takeNextRequestOffset(), sessionIndex });
+	const auto offset = takeNextRequestOffset();
+	const auto parts = chooseRequestParts(offset, sessionIndex);
+	for (auto i = 1; i != parts; ++i) {
+		[[maybe_unused]] const auto next = takeNextRequestOffset();
+		Assert(next == offset + i * int64(Storage::kDownloadPartSize));
+	}
+	makeRequest({ offset, sessionIndex, parts * Storage::kDownloadPartSize });
+}
+
+int DownloadMtprotoTask::nextRequestConsecutiveParts() const {
+	return 0;
+}
+
+bool DownloadMtprotoTask::interactive() const {
+	return false;
+}
+
+int DownloadMtprotoTask::chooseRequestParts(
+		int64 offset,
+		int sessionIndex) const {
+	if (_cdnDcId
+		|| !std::holds_alternative<StorageFileLocation>(_location.data)) {
+		return 1;
+	}
+	const auto limit = std::min(
+		_owner->chooseRequestPartsLimit(dcId(), sessionIndex),
+		nextRequestConsecutiveParts() + 1);
+
+	// upload.getFile requires 1 MB to be divisible by the limit
+	// and the offset to be divisible by the limit as well.
+	auto result = 1;
+	while (result * 2 <= limit
+		&& !(offset % (int64(result * 2) * Storage::kDownloadPartSize))) {
+		result *= 2;
+	}
+	return result;
 }
 
 void DownloadMtprotoTask::removeSession(int sessionIndex) {
 	struct Redirect {
 		mtpRequestId requestId = 0;
 		int64 offset = 0;
+		int limit = 0;
 	};
 	auto redirect = std::vector<Redirect>();
 	for (const auto &[requestId, requestData] : _sentRequests) {
 		if (requestData.sessionIndex == sessionIndex) {
 			redirect.reserve(_sentRequests.size());
-			redirect.push_back({ requestId, requestData.offset });
+			redirect.push_back({
+				requestId,
+				requestData.offset,
+				requestData.limit,
+			});
 		}
 	}
 	for (auto &[requestData, bytes] : _cdnUncheckedParts) {
@@ -498,13 +739,13 @@ void DownloadMtprotoTask::removeSession(int sessionIndex) {
 			requestData.sessionIndex = newIndex;
 		}
 	}
-	for (const auto &[requestId, offset] : redirect) {
+	for (const auto &[requestId, offset, limit] : redirect) {
 		const auto needMakeRequest = (requestId != _cdnHashesRequestId);
 		cancelRequest(requestId);
 		if (needMakeRequest) {
 			const auto newIndex = _owner->chooseSessionIndex(dcId());
 			Assert(newIndex < sessionIndex);
-			makeRequest({ offset, newIndex });
+			makeRequest({ offset, newIndex, limit });
 		}
 	}
 }
@@ -512,7 +753,7 @@ void DownloadMtprotoTask::removeSession(int sessionIndex) {
 mtpRequestId DownloadMtprotoTask::sendRequest(
 		const RequestData &requestData) {
 	const auto offset = requestData.offset;
-	const auto limit = Storage::kDownloadPartSize;
+	const auto limit = requestData.limit;
 	const auto shiftedDcId = MTP::downloadDcId(
 		_cdnDcId ? _cdnDcId : dcId(),
 		requestData.sessionIndex);
@@ -595,6 +836,17 @@ bool DownloadMtprotoTask::setWebFileSizeHook(int64 size) {
 }
 
 void DownloadMtprotoTask::makeRequest(const RequestData &requestData) {
+	if (_cdnDcId && requestData.limit > Storage::kDownloadPartSize) {
+		// CDN file hashes are checked for each kDownloadPartSize part.
+		auto part = requestData;
+		part.limit = Storage::kDownloadPartSize;
+		const auto parts = requestData.limit / Storage::kDownloadPartSize;
+		for (auto i = 0; i != parts; ++i) {
+			placeSentRequest(sendRequest(part), part);
+			part.offset += Storage::kDownloadPartSize;
+		}
+		return;
+	}
 	placeSentRequest(sendRequest(requestData), requestData);
 }
 
@@ -807,7 +1059,7 @@ void DownloadMtprotoTask::placeSentRequest(
 	const auto amount = _owner->changeRequestedAmount(
 		dcId(),
 		requestData.sessionIndex,
-		Storage::kDownloadPartSize);
+		requestData.limit);
 	const auto &[i, ok1] = _sentRequests.emplace(requestId, requestData);
 	const auto &[j, ok2] = _requestByOffset.emplace(
 		requestData.offset,
@@ -851,7 +1103,7 @@ auto DownloadMtprotoTask::finishSentRequest(
 	_owner->changeRequestedAmount(
 		dcId(),
 		result.sessionIndex,
-		-Storage::kDownloadPartSize);
+		-result.limit);
 	_sentRequests.erase(it);
 	const auto ok = _requestByOffset.remove(result.offset);
 
@@ -919,6 +1171,8 @@ void DownloadMtprotoTask::removeFromQueue() {
 void DownloadMtprotoTask::partLoaded(
 		int64 offset,
 		const QByteArray &bytes) {
+	TRACE_SCOPE("DownloadMtprotoTask::partLoaded");
+	TRACE_COUNTER("Downloaded part bytes", bytes.size());
 	feedPart(offset, bytes);
 }
 
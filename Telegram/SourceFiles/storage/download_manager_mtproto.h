@@ -25,6 +25,17 @@ namespace Storage {
 // fixed part size download for hash checking.
 constexpr auto kDownloadPartSize = 128 * 1024;
 
+// In adaptive mode a single upload.getFile request may cover several
+// consecutive parts, up to the protocol maximum of 1 MB. The result is
+// still addressed in kDownloadPartSize units by the loaders.
+constexpr auto kMaxPartsInRequest = 8;
+
+// Below the previous generation priority (-1) that resetGeneration()
+// gives to the default tasks, so preloads always wait for them.
+constexpr auto kDownloadPreloadPriority = -2;
+
+extern const char kOptionAdaptiveDownloads[];
+
 class DownloadMtprotoTask;
 
 class DownloadManagerMtproto final : public base::has_weak_ptr {
@@ -56,6 +67,9 @@ public:
 		crl::time timeAtRequestStart);
 	void checkSendNextAfterSuccess(MTP::DcId dcId);
 	[[nodiscard]] int chooseSessionIndex(MTP::DcId dcId) const;
+	[[nodiscard]] int chooseRequestPartsLimit(
+		MTP::DcId dcId,
+		int index) const;
 
 	void notifyNonPremiumDelay(DocumentId id) {
 		_nonPremiumDelays.fire_copy(id);
@@ -65,21 +79,37 @@ public:
 	}
 
 private:
+	// Tasks with positive priority (streaming) or those that report
+	// interactive() are served first, in the priority / generation order.
+	// Bulk tasks share the rest fairly by the amount already requested,
+	// and a bulk task waiting for too long gets one of every few picks.
+	// The default tasks get the previous generation priority (-1) once
+	// they aren't requested again for a while, preloads with
+	// kDownloadPreloadPriority wait for them and never starve them.
 	class Queue final {
 	public:
 		void enqueue(not_null<Task*> task, int priority);
 		void remove(not_null<Task*> task);
 		void resetGeneration();
 		[[nodiscard]] bool empty() const;
-		[[nodiscard]] Task *nextTask(bool onlyHighestPriority) const;
+		[[nodiscard]] Task *nextTask(
+			bool onlyHighestPriority,
+			bool allowBulk,
+			crl::time now) const;
+		void served(not_null<Task*> task, int amount, crl::time now);
 		void removeSession(int index);
 
 	private:
 		struct Enqueued {
 			not_null<Task*> task;
 			int priority = 0;
+			int64 served = 0;
+			crl::time waitingSince = 0;
 		};
+		[[nodiscard]] static bool Interactive(const Enqueued &enqueued);
+
 		std::vector<Enqueued> _tasks;
+		int _interactiveInRow = 0;
 
 	};
 	struct DcSessionBalanceData {
@@ -88,6 +118,10 @@ private:
 		int requested = 0;
 		int successes = 0; // Since last timeout in this dc in any session.
 		int maxWaitedAmount = 0;
+
+		// Adaptive mode estimates, bandwidth in bytes per second.
+		crl::time minDuration = 0;
+		int64 bandwidth = 0;
 	};
 	struct DcBalanceData {
 		DcBalanceData();
@@ -98,6 +132,7 @@ private:
 		int sessionRemoveTimes = 0;
 		int timeouts = 0; // Since all sessions had successes >= required.
 		int totalRequested = 0;
+		int warmIndex = -1; // Connecting in advance to be added next.
 	};
 
 	void checkSendNext();
@@ -112,6 +147,14 @@ private:
 	void resetGeneration();
 	void sessionTimedOut(MTP::DcId dcId, int index);
 	void removeSession(MTP::DcId dcId);
+	void warmUpNextSession(MTP::DcId dcId, DcBalanceData &dc);
+	void stopWarmSession(MTP::DcId dcId, DcBalanceData &dc);
+	void updateAdaptiveWindow(
+		MTP::DcId dcId,
+		int index,
+		DcSessionBalanceData &data,
+		int amountAtRequestStart,
+		crl::time duration);
 
 	const not_null<ApiWrap*> _api;
 
@@ -155,6 +198,10 @@ public:
 	[[nodiscard]] const Location &location() const;
 
 	[[nodiscard]] virtual bool readyToRequest() const = 0;
+
+	// Small files, like thumbnails and userpics, that are expected
+	// to be shown right away and should not wait behind bulk downloads.
+	[[nodiscard]] virtual bool interactive() const;
 	void loadPart(int sessionIndex);
 	void removeSession(int sessionIndex);
 
@@ -180,6 +227,7 @@ private:
 	struct RequestData {
 		int64 offset = 0;
 		mutable int sessionIndex = 0;
+		int limit = kDownloadPartSize;
 		int requestedInSession = 0;
 		crl::time sent = 0;
 
@@ -206,6 +254,11 @@ private:
 
 	// Called only if readyToRequest() == true.
 	[[nodiscard]] virtual int64 takeNextRequestOffset() = 0;
+
+	// How many more consecutive parts may be taken right after the last
+	// takeNextRequestOffset() and loaded by the same request. A task that
+	// returns non-zero here must accept feedPart() with several parts.
+	[[nodiscard]] virtual int nextRequestConsecutiveParts() const;
 	virtual bool feedPart(int64 offset, const QByteArray &bytes) = 0;
 	virtual bool setWebFileSizeHook(int64 size);
 	virtual void cancelOnFail() = 0;
@@ -238,6 +291,7 @@ private:
 		mtpRequestId requestId);
 	bool cdnPartFailed(const MTP::Error &error, mtpRequestId requestId);
 
+	[[nodiscard]] int chooseRequestParts(int64 offset, int sessionIndex) const;
 	[[nodiscard]] mtpRequestId sendRequest(const RequestData &requestData);
 	void placeSentRequest(
 		mtpRequestId requestId,
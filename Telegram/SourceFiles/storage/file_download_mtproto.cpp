@@ -16,6 +16,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_config.h"
 #include "mtproto/mtproto_auth_key.h"
 
+namespace {
+
+// Files up to this size are thumbnails, userpics and photos the user is
+// looking at, they go ahead of large bulk downloads in the queue.
+constexpr auto kInteractiveFileSize = int64(1024 * 1024);
+
+} // namespace
+
 mtpFileLoader::mtpFileLoader(
 	not_null<Main::Session*> session,
 	const StorageFileLocation &location,
@@ -134,6 +142,10 @@ bool mtpFileLoader::readyToRequest() const {
 		&& (!_fullSize || _nextRequestOffset < _loadSize);
 }
 
+bool mtpFileLoader::interactive() const {
+	return (_fullSize <= kInteractiveFileSize);
+}
+
 int64 mtpFileLoader::takeNextRequestOffset() {
 	Expects(readyToRequest());
 
@@ -142,6 +154,16 @@ int64 mtpFileLoader::takeNextRequestOffset() {
 	return result;
 }
 
+int mtpFileLoader::nextRequestConsecutiveParts() const {
+	if (!_fullSize || _nextRequestOffset >= _loadSize) {
+		return 0;
+	}
+	const auto left = _loadSize - _nextRequestOffset;
+	const auto parts = (left + Storage::kDownloadPartSize - 1)
+		/ Storage::kDownloadPartSize;
+	return int(std::min(parts, int64(Storage::kMaxPartsInRequest)));
+}
+
 bool mtpFileLoader::feedPart(int64 offset, const QByteArray &bytes) {
 	const auto buffer = bytes::make_span(bytes);
 	if (!writeResultPart(offset, buffer)) {
@@ -63,7 +63,9 @@ private:
 	void cancelHook() override;
 
 	bool readyToRequest() const override;
+	bool interactive() const override;
 	int64 takeNextRequestOffset() override;
+	int nextRequestConsecutiveParts() const override;
 	bool feedPart(int64 offset, const QByteArray &bytes) override;
 	void cancelOnFail() override;
 	bool setWebFileSizeHook(int64 size) override;
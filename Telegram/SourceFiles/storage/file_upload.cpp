@@ -20,14 +20,18 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "core/file_location.h"
 #include "core/mime_type.h"
+#include "core/tracing.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
 
 namespace Storage {
 namespace {
 
-// max 1mb uploaded at the same time in each session
-constexpr auto kMaxUploadPerSession = 1024 * 1024;
+// Start with 1mb uploaded at the same time in each session,
+// grow up to 4mb while the acknowledgements keep coming fast.
+constexpr auto kStartUploadPerSession = 1024 * 1024;
+constexpr auto kMaxUploadPerSession = 4 * 1024 * 1024;
+constexpr auto kUploadPerSessionStep = 512 * 1024;
 
 constexpr auto kDocumentMaxPartsCountDefault = 4000;
 
@@ -46,8 +50,8 @@ constexpr auto kDocumentUploadPartSize3 = 256 * 1024;
 // 512kb for large document ( <= 1500mb )
 constexpr auto kDocumentUploadPartSize4 = 512 * 1024;
 
-// One part each half second, if not uploaded faster.
-constexpr auto kUploadRequestInterval = crl::time(250);
+// How many times a single part is sent again after a failure.
+constexpr auto kMaxPartRetries = 3;
 
 // How much time without upload causes additional session kill.
 constexpr auto kKillSessionTimeout = 15 * crl::time(1000);
@@ -87,7 +91,7 @@ struct Uploader::Entry {
 
 	HashMd5 md5Hash;
 
-	std::unique_ptr<QFile> docFile;
+	std::shared_ptr<QFile> docFile;
 	int64 docSize = 0;
 	int64 docSentSize = 0;
 	int docPartSize = 0;
@@ -107,6 +111,25 @@ struct Uploader::Request {
 	bool docPart = false;
 	bool bigPart = false;
 	bool nonPremiumDelayed = false;
+	uchar retries = 0;
+
+	// Keeps the file mapping that 'bytes' point to.
+	std::shared_ptr<MappedPart> mapped;
+};
+
+struct Uploader::MappedPart {
+	MappedPart(std::shared_ptr<QFile> file, uchar *data)
+	: file(std::move(file))
+	, data(data) {
+	}
+	MappedPart(const MappedPart &other) = delete;
+	MappedPart &operator=(const MappedPart &other) = delete;
+	~MappedPart() {
+		file->unmap(data);
+	}
+
+	const std::shared_ptr<QFile> file;
+	uchar * const data = nullptr;
 };
 
 Uploader::Entry::Entry(
@@ -152,7 +175,6 @@ bool Uploader::Entry::setPartSize(int partSize) {
 
 Uploader::Uploader(not_null<ApiWrap*> api)
 : _api(api)
-, _nextTimer([=] { maybeSend(); })
 , _stopSessionsTimer([=] { stopSessions(); }) {
 	const auto session = &_api->session();
 	photoReady(
@@ -331,9 +353,7 @@ void Uploader::upload(
 		}
 	}
 	_queue.push_back({ itemId, file });
-	if (!_nextTimer.isActive()) {
-		maybeSend();
-	}
+	maybeSend();
 }
 
 void Uploader::failed(FullMsgId itemId) {
@@ -377,17 +397,20 @@ void Uploader::stopSessions() {
 			_api->instance().stopSession(MTP::uploadDcId(i));
 		}
 		_sentPerDcIndex.clear();
+		_windowPerDcIndex.clear();
 		_dcIndicesWithFastRequests.clear();
 	}
 }
 
-QByteArray Uploader::readDocPart(not_null<Entry*> entry) {
+QByteArray Uploader::readDocPart(
+		not_null<Entry*> entry,
+		std::shared_ptr<MappedPart> &mapped) {
 	const auto checked = [&](QByteArray result) {
 		if ((entry->file->type == SendMediaType::File
 			|| entry->file->type == SendMediaType::ThemeFile
 			|| entry->file->type == SendMediaType::Audio)
 			&& entry->docSize <= kUseBigFilesFrom) {
-			entry->md5Hash.feed(result.data(), result.size());
+			entry->md5Hash.feed(result.constData(), result.size());
 		}
 		if (result.isEmpty()
 			|| (result.size() > entry->docPartSize)
@@ -403,12 +426,39 @@ QByteArray Uploader::readDocPart(not_null<Entry*> entry) {
 		return checked(content.mid(offset, entry->docPartSize));
 	} else if (!entry->docFile) {
 		const auto filepath = entry->file->filepath;
-		entry->docFile = std::make_unique<QFile>(filepath);
-		if (!entry->docFile->open(QIODevice::ReadOnly)) {
+		entry->docFile = std::make_shared<QFile>(filepath);
+		if (!entry->docFile->open(QIODevice::ReadOnly
+			| QIODevice::Unbuffered)) {
 			return QByteArray();
 		}
 	}
-	return checked(entry->docFile->read(entry->docPartSize));
+
+	// Map only the part being sent, so that the memory is released
+	// as soon as the part is acknowledged, even for very big files.
+	const auto &file = entry->docFile;
+	const auto offset = entry->docPartsSent * int64(entry->docPartSize);
+	const auto size = int(std::clamp(
+		entry->docSize - offset,
+		int64(0),
+		int64(entry->docPartSize)));
+	if (size > 0 && offset + size <= file->size()) {
+		if (const auto data = file->map(offset, size)) {
+			mapped = std::make_shared<MappedPart>(file, data);
+			return checked(QByteArray::fromRawData(
+				reinterpret_cast<const char*>(data),
+				size));
+		}
+	}
+	if (!file->seek(offset)) {
+		return QByteArray();
+	}
+	auto result = QByteArray(entry->docPartSize, Qt::Uninitialized);
+	const auto read = file->read(result.data(), result.size());
+	if (read <= 0) {
+		return QByteArray();
+	}
+	result.resize(read);
+	return checked(std::move(result));
 }
 
 bool Uploader::canAddDcIndex() const {
@@ -427,6 +477,7 @@ std::optional<uchar> Uploader::chooseDcIndexForNextRequest(
 	if (canAddDcIndex()) {
 		const auto result = int(_sentPerDcIndex.size());
 		_sentPerDcIndex.push_back(0);
+		_windowPerDcIndex.push_back(kStartUploadPerSession);
 		_dcIndicesWithFastRequests.clear();
 		_latestDcIndexAdded = crl::now();
 
@@ -445,8 +496,8 @@ std::optional<uchar> Uploader::chooseDcIndexForNextRequest(
 }
 
 Uploader::Entry *Uploader::chooseEntryForNextRequest() {
-	if (!_pendingFromRemovedDcIndices.empty()) {
-		const auto itemId = _pendingFromRemovedDcIndices.front().itemId;
+	if (!_pendingRequests.empty()) {
+		const auto itemId = _pendingRequests.front().itemId;
 		const auto i = ranges::find(_queue, itemId, &Entry::itemId);
 		Assert(i != end(_queue));
 		return &*i;
@@ -463,7 +514,7 @@ Uploader::Entry *Uploader::chooseEntryForNextRequest() {
 
 auto Uploader::sendPart(not_null<Entry*> entry, uchar dcIndex)
 -> SendResult {
-	return !_pendingFromRemovedDcIndices.empty()
+	return !_pendingRequests.empty()
 		? sendPendingPart(entry, dcIndex)
 		: (entry->partsSent < entry->parts->size())
 		? sendSlicedPart(entry, dcIndex)
@@ -491,11 +542,17 @@ void Uploader::sendPreparedRequest(Prepared &&prepared, Request &&request) {
 
 auto Uploader::sendPendingPart(not_null<Entry*> entry, uchar dcIndex)
 -> SendResult {
-	Expects(!_pendingFromRemovedDcIndices.empty());
-	Expects(_pendingFromRemovedDcIndices.front().itemId == entry->itemId);
+	Expects(!_pendingRequests.empty());
+	Expects(_pendingRequests.front().itemId == entry->itemId);
 
-	auto request = std::move(_pendingFromRemovedDcIndices.front());
-	_pendingFromRemovedDcIndices.erase(begin(_pendingFromRemovedDcIndices));
+	const auto alreadySent = _sentPerDcIndex[dcIndex];
+	const auto willBeSent = _pendingRequests.front().bytes.size();
+	if (alreadySent && alreadySent + willBeSent > _windowPerDcIndex[dcIndex]) {
+		return SendResult::DcIndexFull;
+	}
+
+	auto request = std::move(_pendingRequests.front());
+	_pendingRequests.erase(begin(_pendingRequests));
 
 	const auto part = request.part;
 	const auto bytes = request.bytes;
@@ -523,13 +580,14 @@ auto Uploader::sendDocPart(not_null<Entry*> entry, uchar dcIndex)
 	const auto itemId = entry->itemId;
 	const auto alreadySent = _sentPerDcIndex[dcIndex];
 	const auto willProbablyBeSent = entry->docPartSize;
-	if (alreadySent + willProbablyBeSent > kMaxUploadPerSession) {
+	if (alreadySent + willProbablyBeSent > _windowPerDcIndex[dcIndex]) {
 		return SendResult::DcIndexFull;
 	}
 
 	Assert(entry->docPartsSent < entry->docPartsCount);
 
-	const auto partBytes = readDocPart(entry);
+	auto mapped = std::shared_ptr<MappedPart>();
+	const auto partBytes = readDocPart(entry, mapped);
 	if (partBytes.isEmpty()) {
 		failed(itemId);
 		return SendResult::Failed;
@@ -545,6 +603,7 @@ auto Uploader::sendDocPart(not_null<Entry*> entry, uchar dcIndex)
 			.dcIndex = dcIndex,
 			.docPart = true,
 			.bigPart = big,
+			.mapped = mapped,
 		});
 	};
 	if (entry->docSize > kUseBigFilesFrom) {
@@ -569,7 +628,7 @@ auto Uploader::sendSlicedPart(not_null<Entry*> entry, uchar dcIndex)
 	const auto itemId = entry->itemId;
 	const auto alreadySent = _sentPerDcIndex[dcIndex];
 	const auto willBeSent = entry->parts->at(entry->partsSent).size();
-	if (alreadySent + willBeSent >= kMaxUploadPerSession) {
+	if (alreadySent + willBeSent >= _windowPerDcIndex[dcIndex]) {
 		return SendResult::DcIndexFull;
 	}
 
@@ -583,6 +642,7 @@ auto Uploader::sendSlicedPart(not_null<Entry*> entry, uchar dcIndex)
 	), {
 		.itemId = itemId,
 		.bytes = partBytes,
+		.part = index,
 		.dcIndex = dcIndex,
 	});
 	return SendResult::Success;
@@ -602,9 +662,11 @@ void Uploader::maybeSend() {
 		_stopSessionsTimer.cancel();
 	}
 
-	auto usedDcIndices = base::flat_set<uchar>();
+	// Fill each session up to its window, every acknowledgement
+	// calls us again to refill the session it was received in.
+	auto fullDcIndices = base::flat_set<uchar>();
 	while (true) {
-		const auto maybeDcIndex = chooseDcIndexForNextRequest(usedDcIndices);
+		const auto maybeDcIndex = chooseDcIndexForNextRequest(fullDcIndices);
 		if (!maybeDcIndex.has_value()) {
 			break;
 		}
@@ -616,20 +678,13 @@ void Uploader::maybeSend() {
 			}
 			const auto result = sendPart(entry, dcIndex);
 			if (result == SendResult::DcIndexFull) {
-				return;
+				fullDcIndices.emplace(dcIndex);
+				break;
 			} else if (result == SendResult::Success) {
 				break;
 			}
 			// If this entry failed, we try the next one.
 		}
-		if (_sentPerDcIndex[dcIndex] >= kAcceptAsFastIfTotalAtLeast) {
-			usedDcIndices.emplace(dcIndex);
-		}
-	}
-	if (usedDcIndices.empty()) {
-		_nextTimer.cancel();
-	} else {
-		_nextTimer.callOnce(kUploadRequestInterval);
 	}
 }
 
@@ -665,11 +720,11 @@ void Uploader::cancelRequests(FullMsgId itemId) {
 			++i;
 		}
 	}
-	_pendingFromRemovedDcIndices.erase(ranges::remove(
-		_pendingFromRemovedDcIndices,
+	_pendingRequests.erase(ranges::remove(
+		_pendingRequests,
 		itemId,
 		&Request::itemId
-	), end(_pendingFromRemovedDcIndices));
+	), end(_pendingRequests));
 }
 
 void Uploader::cancelAllRequests() {
@@ -695,13 +750,15 @@ Uploader::Request Uploader::finishRequest(mtpRequestId requestId) {
 }
 
 void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
-	const auto request = finishRequest(requestId);
+	TRACE_SCOPE("Uploader::partLoaded");
+	auto request = finishRequest(requestId);
 
 	const auto bytes = int(request.bytes.size());
+	TRACE_COUNTER("Uploaded part bytes", bytes);
 	const auto itemId = request.itemId;
 
-	if (mtpIsFalse(result)) { // failed to upload current file
-		failed(itemId);
+	if (mtpIsFalse(result)) { // failed to upload current part
+		retransmit(std::move(request));
 		return;
 	}
 
@@ -715,7 +772,9 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 	const auto slowish = !fast;
 	const auto slow = (duration >= kSlowRequestThreshold);
 
+	auto &window = _windowPerDcIndex[request.dcIndex];
 	if (slowish) {
+		window = std::max(window / 2, kStartUploadPerSession);
 		_dcIndicesWithFastRequests.clear();
 		if (slow) {
 			const auto elapsed = (now - _latestDcIndexRemoved);
@@ -730,9 +789,19 @@ void Uploader::partLoaded(const MTPBool &result, mtpRequestId requestId) {
 		} else {
 			DEBUG_LOG(("Uploader: Slow-ish request, clear fast records."));
 		}
-	} else if (request.sent > _latestDcIndexAdded
-		&& (request.queued + bytes >= kAcceptAsFastIfTotalAtLeast)) {
-		if (_dcIndicesWithFastRequests.emplace(request.dcIndex).second) {
+	} else {
+		if (request.queued + bytes + kUploadPerSessionStep >= window
+			&& window < kMaxUploadPerSession) {
+			window = std::min(
+				window + kUploadPerSessionStep,
+				kMaxUploadPerSession);
+			DEBUG_LOG(("Uploader: Window of %1 is now %2."
+				).arg(request.dcIndex
+				).arg(window));
+		}
+		if (request.sent > _latestDcIndexAdded
+			&& (request.queued + bytes >= kAcceptAsFastIfTotalAtLeast)
+			&& _dcIndicesWithFastRequests.emplace(request.dcIndex).second) {
 			DEBUG_LOG(("Uploader: Mark %1 of %2 as fast."
 				).arg(request.dcIndex
 				).arg(_sentPerDcIndex.size()));
@@ -790,7 +859,7 @@ void Uploader::removeDcIndex() {
 			const auto bytes = int(i->second.bytes.size());
 			_sentPerDcIndex[dcIndex] -= bytes;
 			_api->request(i->first).cancel();
-			_pendingFromRemovedDcIndices.push_back(std::move(i->second));
+			_pendingRequests.push_back(std::move(i->second));
 			i = _requests.erase(i);
 		} else {
 			++i;
@@ -798,6 +867,7 @@ void Uploader::removeDcIndex() {
 	}
 	Assert(_sentPerDcIndex.back() == 0);
 	_sentPerDcIndex.pop_back();
+	_windowPerDcIndex.pop_back();
 	_dcIndicesWithFastRequests.remove(dcIndex);
 	_api->instance().stopSession(MTP::uploadDcId(dcIndex));
 	DEBUG_LOG(("Uploader: Removed dc index %1.").arg(dcIndex));
@@ -902,8 +972,30 @@ void Uploader::finishFront() {
 }
 
 void Uploader::partFailed(const MTP::Error &error, mtpRequestId requestId) {
-	const auto request = finishRequest(requestId);
-	failed(request.itemId);
+	auto request = finishRequest(requestId);
+	const auto code = error.code();
+	if (code == 400 || code == 403 || code == 406) {
+		// Bad part, the file itself can't be uploaded.
+		failed(request.itemId);
+		return;
+	}
+	retransmit(std::move(request));
+}
+
+void Uploader::retransmit(Request &&request) {
+	const auto itemId = request.itemId;
+	if (++request.retries > kMaxPartRetries) {
+		failed(itemId);
+		return;
+	}
+	DEBUG_LOG(("Uploader: Retransmitting part %1, retry %2."
+		).arg(request.part
+		).arg(request.retries));
+	request.nonPremiumDelayed = false;
+	_pendingRequests.push_back(std::move(request));
+	crl::on_main(this, [=] {
+		maybeSend();
+	});
 }
 
 } // namespace Storage
@@ -102,6 +102,7 @@ public:
 private:
 	struct Entry;
 	struct Request;
+	struct MappedPart;
 
 	enum class SendResult : uchar {
 		Success,
@@ -121,7 +122,9 @@ private:
 		-> SendResult;
 	[[nodiscard]] auto sendSlicedPart(not_null<Entry*> entry, uchar dcIndex)
 		-> SendResult;
-	[[nodiscard]] QByteArray readDocPart(not_null<Entry*> entry);
+	[[nodiscard]] QByteArray readDocPart(
+		not_null<Entry*> entry,
+		std::shared_ptr<MappedPart> &mapped);
 	void removeDcIndex();
 
 	template <typename Prepared>
@@ -132,6 +135,7 @@ private:
 
 	void partLoaded(const MTPBool &result, mtpRequestId requestId);
 	void partFailed(const MTP::Error &error, mtpRequestId requestId);
+	void retransmit(Request &&request);
 	Request finishRequest(mtpRequestId requestId);
 
 	void processPhotoProgress(FullMsgId itemId);
@@ -156,15 +160,18 @@ private:
 
 	base::flat_map<mtpRequestId, Request> _requests;
 	std::vector<int> _sentPerDcIndex;
+	std::vector<int> _windowPerDcIndex;
 
 	// Fast requests since the latest dc index addition.
 	base::flat_set<uchar> _dcIndicesWithFastRequests;
 	crl::time _latestDcIndexAdded = 0;
 	crl::time _latestDcIndexRemoved = 0;
-	std::vector<Request> _pendingFromRemovedDcIndices;
+
+	// Parts from removed dc indices and failed parts to be sent again.
+	std::vector<Request> _pendingRequests;
 
 	FullMsgId _pausedId;
-	base::Timer _nextTimer, _stopSessionsTimer;
+	base::Timer _stopSessionsTimer;
 
 	rpl::event_stream<UploadedMedia> _photoReady;
 	rpl::event_stream<UploadedMedia> _documentReady;
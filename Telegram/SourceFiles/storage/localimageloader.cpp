@@ -222,7 +222,8 @@ int PhotoSideLimit() {
 	return PhotoSideLimit(SendLargePhotos.value());
 }
 
-TaskQueue::TaskQueue(crl::time stopTimeoutMs) {
+TaskQueue::TaskQueue(crl::time stopTimeoutMs, int threadsCount)
+: _threadsCount(std::max(threadsCount, 1)) {
 	if (stopTimeoutMs > 0) {
 		_stopTimer = new QTimer(this);
 		connect(_stopTimer, SIGNAL(timeout()), this, SLOT(stop()));
@@ -255,19 +256,56 @@ void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 }
 
 void TaskQueue::wakeThread() {
-	if (!_thread) {
-		_thread = new QThread();
+	if (_threads.empty()) {
+		for (auto i = 0; i != _threadsCount; ++i) {
+			const auto thread = new QThread();
+			const auto worker = new TaskQueueWorker(this);
+			worker->moveToThread(thread);
+
+			connect(this, SIGNAL(taskAdded()), worker, SLOT(onTaskAdded()));
+			connect(worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
+
+			thread->start();
+			_threads.push_back(thread);
+			_workers.push_back(worker);
+		}
+	}
+	if (_stopTimer) _stopTimer->stop();
+	taskAdded();
+}
 
-		_worker = new TaskQueueWorker(this);
-		_worker->moveToThread(_thread);
+std::unique_ptr<Task> TaskQueue::takeTaskToProcess() {
+	QMutexLocker lock(&_tasksToProcessMutex);
+	if (_tasksToProcess.empty()) {
+		return nullptr;
+	}
+	auto result = std::move(_tasksToProcess.front());
+	_tasksToProcess.pop_front();
+	_tasksInProcess.push_back({ .id = result->id() });
+	return result;
+}
 
-		connect(this, SIGNAL(taskAdded()), _worker, SLOT(onTaskAdded()));
-		connect(_worker, SIGNAL(taskProcessed()), this, SLOT(onTaskProcessed()));
+bool TaskQueue::taskProcessed(std::unique_ptr<Task> task) {
+	QMutexLocker lockToProcess(&_tasksToProcessMutex);
+	const auto i = ranges::find(_tasksInProcess, task->id(), &InProcess::id);
+	Assert(i != end(_tasksInProcess));
+	if (i->cancelled) {
+		_tasksInProcess.erase(i);
+	} else {
+		i->processed = base::take(task);
+	}
 
-		_thread->start();
+	// Earlier added tasks may still be processed by other workers.
+	QMutexLocker lockToFinish(&_tasksToFinishMutex);
+	const auto wasEmpty = _tasksToFinish.empty();
+	while (!_tasksInProcess.empty() && _tasksInProcess.front().processed) {
+		auto &first = _tasksInProcess.front();
+		if (!first.cancelled) {
+			_tasksToFinish.push_back(std::move(first.processed));
+		}
+		_tasksInProcess.pop_front();
 	}
-	if (_stopTimer) _stopTimer->stop();
-	taskAdded();
+	return wasEmpty && !_tasksToFinish.empty();
 }
 
 void TaskQueue::cancelTask(TaskId id) {
@@ -283,8 +321,9 @@ void TaskQueue::cancelTask(TaskId id) {
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
 		removeFrom(_tasksToProcess);
-		if (_taskInProcessId == id) {
-			_taskInProcessId = TaskId();
+		const auto i = ranges::find(_tasksInProcess, id, &InProcess::id);
+		if (i != end(_tasksInProcess)) {
+			i->cancelled = true;
 		}
 	}
 	QMutexLocker lock(&_tasksToFinishMutex);
@@ -305,24 +344,32 @@ void TaskQueue::onTaskProcessed() {
 
 	if (_stopTimer) {
 		QMutexLocker lock(&_tasksToProcessMutex);
-		if (_tasksToProcess.empty() && !_taskInProcessId) {
+		if (_tasksToProcess.empty() && _tasksInProcess.empty()) {
 			_stopTimer->start();
 		}
 	}
 }
 
 void TaskQueue::stop() {
-	if (_thread) {
-		_thread->requestInterruption();
-		_thread->quit();
-		DEBUG_LOG(("Waiting for taskThread to finish"));
-		_thread->wait();
-		delete base::take(_worker);
-		delete base::take(_thread);
+	for (const auto thread : _threads) {
+		thread->requestInterruption();
+		thread->quit();
+	}
+	if (!_threads.empty()) {
+		DEBUG_LOG(("Waiting for taskThreads to finish"));
+	}
+	for (const auto thread : _threads) {
+		thread->wait();
+	}
+	for (const auto worker : base::take(_workers)) {
+		delete worker;
+	}
+	for (const auto thread : base::take(_threads)) {
+		delete thread;
 	}
 	_tasksToProcess.clear();
+	_tasksInProcess.clear();
 	_tasksToFinish.clear();
-	_taskInProcessId = TaskId();
 }
 
 TaskQueue::~TaskQueue() {
@@ -334,38 +381,19 @@ void TaskQueueWorker::onTaskAdded() {
 	if (_inTaskAdded) return;
 	_inTaskAdded = true;
 
-	bool someTasksLeft = false;
-	do {
-		auto task = std::unique_ptr<Task>();
-		{
-			QMutexLocker lock(&_queue->_tasksToProcessMutex);
-			if (!_queue->_tasksToProcess.empty()) {
-				task = std::move(_queue->_tasksToProcess.front());
-				_queue->_tasksToProcess.pop_front();
-				_queue->_taskInProcessId = task->id();
-			}
+	// Each worker takes the next task as soon as it is free,
+	// so a batch of tasks is spread between all the workers.
+	while (!thread()->isInterruptionRequested()) {
+		auto task = _queue->takeTaskToProcess();
+		if (!task) {
+			break;
 		}
-
-		if (task) {
-			task->process();
-			bool emitTaskProcessed = false;
-			{
-				QMutexLocker lockToProcess(&_queue->_tasksToProcessMutex);
-				if (_queue->_taskInProcessId == task->id()) {
-					_queue->_taskInProcessId = TaskId();
-					someTasksLeft = !_queue->_tasksToProcess.empty();
-
-					QMutexLocker lockToFinish(&_queue->_tasksToFinishMutex);
-					emitTaskProcessed = _queue->_tasksToFinish.empty();
-					_queue->_tasksToFinish.push_back(std::move(task));
-				}
-			}
-			if (emitTaskProcessed) {
-				taskProcessed();
-			}
+		task->process();
+		if (_queue->taskProcessed(std::move(task))) {
+			taskProcessed();
 		}
 		QCoreApplication::processEvents();
-	} while (someTasksLeft && !thread()->isInterruptionRequested());
+	}
 
 	_inTaskAdded = false;
 }
@@ -896,11 +924,12 @@ void FileLoadTask::process(Args &&args) {
 				if (Core::IsMimeSticker(filemime)) {
 					fullimage = Images::Opaque(std::move(fullimage));
 				}
-				auto medium = (w > 320 || h > 320) ? fullimage.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
-
 				const auto limit = PhotoSideLimitAtomic();
 				const auto downscaled = (w > limit || h > limit);
 				auto full = downscaled ? fullimage.scaled(limit, limit, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
+
+				// Scale the medium size from the already downscaled image.
+				auto medium = (w > 320 || h > 320) ? full.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : full;
 				if (downscaled) {
 					fullimagebytes = fullimageformat = QByteArray();
 				}
@@ -52,11 +52,16 @@ public:
 };
 
 class TaskQueueWorker;
+
+// Tasks are processed by up to threadsCount workers in parallel,
+// but finish() is always called in the order the tasks were added.
 class TaskQueue : public QObject {
 	Q_OBJECT
 
 public:
-	explicit TaskQueue(crl::time stopTimeoutMs = 0); // <= 0 - never stop worker
+	explicit TaskQueue(
+		crl::time stopTimeoutMs = 0, // <= 0 - never stop workers
+		int threadsCount = 1);
 
 	TaskId addTask(std::unique_ptr<Task> &&task);
 	void addTasks(std::vector<std::unique_ptr<Task>> &&tasks);
@@ -74,14 +79,26 @@ public Q_SLOTS:
 private:
 	friend class TaskQueueWorker;
 
+	struct InProcess {
+		TaskId id = kEmptyTaskId;
+		std::unique_ptr<Task> processed;
+		bool cancelled = false;
+	};
+
 	void wakeThread();
+	[[nodiscard]] std::unique_ptr<Task> takeTaskToProcess();
+	[[nodiscard]] bool taskProcessed(std::unique_ptr<Task> task);
 
+	const int _threadsCount = 1;
+
+	// Guarded by _tasksToProcessMutex, in the order of addTask() calls.
 	std::deque<std::unique_ptr<Task>> _tasksToProcess;
+	std::deque<InProcess> _tasksInProcess;
+
 	std::deque<std::unique_ptr<Task>> _tasksToFinish;
-	TaskId _taskInProcessId = TaskId();
 	QMutex _tasksToProcessMutex, _tasksToFinishMutex;
-	QThread *_thread = nullptr;
-	TaskQueueWorker *_worker = nullptr;
+	std::vector<QThread*> _threads;
+	std::vector<TaskQueueWorker*> _workers;
 	QTimer *_stopTimer = nullptr;
 
 };
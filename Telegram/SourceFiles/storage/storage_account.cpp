@@ -94,6 +94,7 @@ enum { // Local Storage Keys
 	lskCustomEmojiKeys = 0x17, // no data
 	lskSearchSuggestions = 0x18, // no data
 	lskWebviewTokens = 0x19, // data: QByteArray bots, QByteArray other
+	lskAppConfig = 0x1a, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -180,6 +181,17 @@ std::unique_ptr<MTP::Config> Account::start(MTP::AuthKeyPtr localKey) {
 	return readMtpConfig();
 }
 
+void Account::prefetchStart(const MTP::AuthKeyPtr &localKey) {
+	Expects(localKey != nullptr);
+
+	PrefetchFile(u"map"_q, _basePath);
+	PrefetchEncryptedFile(
+		ToFilePart(_dataNameKey),
+		BaseGlobalPath(),
+		localKey);
+	PrefetchEncryptedFile(u"config"_q, _basePath, localKey);
+}
+
 void Account::startAdded(MTP::AuthKeyPtr localKey) {
 	Expects(localKey != nullptr);
 
@@ -220,6 +232,7 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		_featuredCustomEmojiKey,
 		_archivedCustomEmojiKey,
 		_searchSuggestionsKey,
+		_appConfigKey,
 	};
 	auto result = base::flat_set<QString>{
 		"map0",
@@ -306,6 +319,7 @@ Account::ReadMapResult Account::readMapWith(
 	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
 	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
 	quint64 searchSuggestionsKey = 0;
+	quint64 appConfigKey = 0;
 	QByteArray webviewStorageTokenBots, webviewStorageTokenOther;
 	while (!map.stream.atEnd()) {
 		quint32 keyType;
@@ -415,6 +429,9 @@ Account::ReadMapResult Account::readMapWith(
 		case lskSearchSuggestions: {
 			map.stream >> searchSuggestionsKey;
 		} break;
+		case lskAppConfig: {
+			map.stream >> appConfigKey;
+		} break;
 		case lskWebviewTokens: {
 			map.stream
 				>> webviewStorageTokenBots
@@ -456,6 +473,7 @@ Account::ReadMapResult Account::readMapWith(
 	_recentHashtagsAndBotsKey = recentHashtagsAndBotsKey;
 	_exportSettingsKey = exportSettingsKey;
 	_searchSuggestionsKey = searchSuggestionsKey;
+	_appConfigKey = appConfigKey;
 	_oldMapVersion = mapData.version;
 	_webviewStorageIdBots.token = webviewStorageTokenBots;
 	_webviewStorageIdOther.token = webviewStorageTokenOther;
@@ -467,7 +485,7 @@ Account::ReadMapResult Account::readMapWith(
 	}
 
 	if (_locationsKey) {
-		readLocations();
+		startReadingLocations();
 	}
 	if (_legacyBackgroundKeyDay || _legacyBackgroundKeyNight) {
 		Local::moveLegacyBackground(
@@ -564,6 +582,7 @@ void Account::writeMap() {
 		mapSize += sizeof(quint32) + 3 * sizeof(quint64);
 	}
 	if (_searchSuggestionsKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_appConfigKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (!_webviewStorageIdBots.token.isEmpty()
 		|| !_webviewStorageIdOther.token.isEmpty()) {
 		mapSize += sizeof(quint32)
@@ -633,6 +652,9 @@ void Account::writeMap() {
 		mapData.stream << quint32(lskSearchSuggestions);
 		mapData.stream << quint64(_searchSuggestionsKey);
 	}
+	if (_appConfigKey) {
+		mapData.stream << quint32(lskAppConfig) << quint64(_appConfigKey);
+	}
 	if (!_webviewStorageIdBots.token.isEmpty()
 		|| !_webviewStorageIdOther.token.isEmpty()) {
 		mapData.stream << quint32(lskWebviewTokens);
@@ -669,10 +691,13 @@ void Account::reset() {
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
 	_searchSuggestionsKey = 0;
+	_appConfigKey = 0;
 	_oldMapVersion = 0;
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
 	_fileLocationAliases.clear();
+	_pendingLocations = nullptr;
+	_locationsRead = true;
 	_downloadsSerialize = nullptr;
 	_downloadsSerialized = QByteArray();
 	_cacheTotalSizeLimit = Database::Settings().totalSizeLimit;
@@ -726,6 +751,7 @@ void Account::writeLocations() {
 	if (!_locationsChanged) {
 		return;
 	}
+	ensureLocationsRead();
 	_locationsChanged = false;
 
 	if (_downloadsSerialize) {
@@ -812,13 +838,30 @@ void Account::writeLocationsDelayed() {
 	_writeLocationsTimer.callOnce(kDelayedWriteTimeout);
 }
 
-void Account::readLocations() {
+struct Account::LocationsData {
+	QMultiMap<MediaKey, Core::FileLocation> locations;
+	QMap<QString, QPair<MediaKey, Core::FileLocation>> pairs;
+	QMap<MediaKey, MediaKey> aliases;
+	std::vector<FileKey> legacyWebLocations;
+	QByteArray downloadsSerialized;
+	bool failed = false;
+};
+
+struct Account::PendingLocations {
+	QMutex mutex;
+	std::optional<LocationsData> result;
+	bool taken = false;
+};
+
+Account::LocationsData Account::ReadLocations(
+		FileKey locationsKey,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &localKey) {
+	auto result = LocationsData();
 	FileReadDescriptor locations;
-	if (!ReadEncryptedFile(locations, _locationsKey, _basePath, _localKey)) {
-		ClearKey(_locationsKey, _basePath);
-		_locationsKey = 0;
-		writeMapDelayed();
-		return;
+	if (!ReadEncryptedFile(locations, locationsKey, basePath, localKey)) {
+		result.failed = true;
+		return result;
 	}
 
 	bool endMarkFound = false;
@@ -843,9 +886,9 @@ void Account::readLocations() {
 
 		MediaKey key(first, second);
 
-		_fileLocations.insert(key, loc);
+		result.locations.insert(key, loc);
 		if (!loc.inMediaCache()) {
-			_fileLocationPairs.insert(loc.fname, { key, loc });
+			result.pairs.insert(loc.fname, { key, loc });
 		}
 	}
 
@@ -855,7 +898,7 @@ void Account::readLocations() {
 		for (quint32 i = 0; i < cnt; ++i) {
 			quint64 kfirst, ksecond, vfirst, vsecond;
 			locations.stream >> kfirst >> ksecond >> vfirst >> vsecond;
-			_fileLocationAliases.insert(MediaKey(kfirst, ksecond), MediaKey(vfirst, vsecond));
+			result.aliases.insert(MediaKey(kfirst, ksecond), MediaKey(vfirst, vsecond));
 		}
 
 		if (!locations.stream.atEnd()) {
@@ -866,14 +909,67 @@ void Account::readLocations() {
 				quint64 key;
 				qint32 size;
 				locations.stream >> url >> key >> size;
-				ClearKey(key, _basePath);
+				result.legacyWebLocations.push_back(key);
 			}
 
 			if (!locations.stream.atEnd()) {
-				locations.stream >> _downloadsSerialized;
+				locations.stream >> result.downloadsSerialized;
 			}
 		}
 	}
+	return result;
+}
+
+void Account::startReadingLocations() {
+	Expects(_locationsKey != 0);
+
+	_locationsRead = false;
+	_pendingLocations = std::make_shared<PendingLocations>();
+	crl::async([
+		pending = _pendingLocations,
+		locationsKey = _locationsKey,
+		basePath = _basePath,
+		localKey = _localKey
+	] {
+		auto result = ReadLocations(locationsKey, basePath, localKey);
+		QMutexLocker lock(&pending->mutex);
+		if (!pending->taken) {
+			pending->result = std::move(result);
+		}
+	});
+}
+
+void Account::ensureLocationsRead() {
+	if (_locationsRead) {
+		return;
+	}
+	_locationsRead = true;
+
+	auto result = std::optional<LocationsData>();
+	if (const auto pending = base::take(_pendingLocations)) {
+		QMutexLocker lock(&pending->mutex);
+		pending->taken = true;
+		result = base::take(pending->result);
+	}
+	applyLocations(result
+		? std::move(*result)
+		: ReadLocations(_locationsKey, _basePath, _localKey));
+}
+
+void Account::applyLocations(LocationsData &&data) {
+	if (data.failed) {
+		ClearKey(_locationsKey, _basePath);
+		_locationsKey = 0;
+		writeMapDelayed();
+		return;
+	}
+	for (const auto key : data.legacyWebLocations) {
+		ClearKey(key, _basePath);
+	}
+	_fileLocations = std::move(data.locations);
+	_fileLocationPairs = std::move(data.pairs);
+	_fileLocationAliases = std::move(data.aliases);
+	_downloadsSerialized = std::move(data.downloadsSerialized);
 }
 
 void Account::updateDownloads(
@@ -882,7 +978,8 @@ void Account::updateDownloads(
 	writeLocationsDelayed();
 }
 
-QByteArray Account::downloadsSerialized() const {
+QByteArray Account::downloadsSerialized() {
+	ensureLocationsRead();
 	return _downloadsSerialized;
 }
 
@@ -1608,6 +1705,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 	if (local.fname.isEmpty()) {
 		return;
 	}
+	ensureLocationsRead();
 	if (!local.inMediaCache()) {
 		const auto aliasIt = _fileLocationAliases.constFind(location);
 		if (aliasIt != _fileLocationAliases.cend()) {
@@ -1647,6 +1745,7 @@ void Account::writeFileLocation(MediaKey location, const Core::FileLocation &loc
 }
 
 void Account::removeFileLocation(MediaKey location) {
+	ensureLocationsRead();
 	auto i = _fileLocations.find(location);
 	if (i == _fileLocations.end()) {
 		return;
@@ -1658,6 +1757,7 @@ void Account::removeFileLocation(MediaKey location) {
 }
 
 Core::FileLocation Account::readFileLocation(MediaKey location) {
+	ensureLocationsRead();
 	const auto aliasIt = _fileLocationAliases.constFind(location);
 	if (aliasIt != _fileLocationAliases.cend()) {
 		location = aliasIt.value();
@@ -2976,6 +3076,44 @@ void Account::readSearchSuggestions() {
 	}
 }
 
+void Account::writeAppConfig(const QByteArray &serialized) {
+	if (serialized.isEmpty()) {
+		if (_appConfigKey) {
+			ClearKey(_appConfigKey, _basePath);
+			_appConfigKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_appConfigKey) {
+		_appConfigKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	EncryptedDescriptor data(Serialize::bytearraySize(serialized));
+	data.stream << serialized;
+
+	FileWriteDescriptor file(_appConfigKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+QByteArray Account::readAppConfig() {
+	if (!_appConfigKey) {
+		return QByteArray();
+	}
+
+	FileReadDescriptor config;
+	if (!ReadEncryptedFile(config, _appConfigKey, _basePath, _localKey)) {
+		ClearKey(_appConfigKey, _basePath);
+		_appConfigKey = 0;
+		writeMapDelayed();
+		return QByteArray();
+	}
+
+	auto result = QByteArray();
+	config.stream >> result;
+	return CheckStreamStatus(config.stream) ? result : QByteArray();
+}
+
 void Account::writeSelf() {
 	writeMapDelayed();
 }
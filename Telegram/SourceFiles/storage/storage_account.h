@@ -71,6 +71,7 @@ public:
 	[[nodiscard]] std::unique_ptr<MTP::Config> start(
 		MTP::AuthKeyPtr localKey);
 	void startAdded(MTP::AuthKeyPtr localKey);
+	void prefetchStart(const MTP::AuthKeyPtr &localKey);
 	[[nodiscard]] int oldMapVersion() const {
 		return _oldMapVersion;
 	}
@@ -105,7 +106,7 @@ public:
 	void removeFileLocation(MediaKey location);
 
 	void updateDownloads(Fn<std::optional<QByteArray>()> downloadsSerialize);
-	[[nodiscard]] QByteArray downloadsSerialized() const;
+	[[nodiscard]] QByteArray downloadsSerialized();
 
 	[[nodiscard]] EncryptionKey cacheKey() const;
 	[[nodiscard]] QString cachePath() const;
@@ -154,6 +155,9 @@ public:
 	void writeSearchSuggestions();
 	void readSearchSuggestions();
 
+	void writeAppConfig(const QByteArray &serialized);
+	[[nodiscard]] QByteArray readAppConfig();
+
 	void writeSelf();
 
 	// Read self is special, it can't get session from account, because
@@ -212,7 +216,15 @@ private:
 	void writeMapQueued();
 	void writeMap();
 
-	void readLocations();
+	struct LocationsData;
+	struct PendingLocations;
+	[[nodiscard]] static LocationsData ReadLocations(
+		FileKey locationsKey,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &localKey);
+	void startReadingLocations();
+	void ensureLocationsRead();
+	void applyLocations(LocationsData &&data);
 	void writeLocations();
 	void writeLocationsQueued();
 	void writeLocationsDelayed();
@@ -281,6 +293,10 @@ private:
 	QByteArray _downloadsSerialized;
 	Fn<std::optional<QByteArray>()> _downloadsSerialize;
 
+	// Locations are decrypted in the background after the map is read.
+	std::shared_ptr<PendingLocations> _pendingLocations;
+	bool _locationsRead = true;
+
 	FileKey _locationsKey = 0;
 	FileKey _trustedBotsKey = 0;
 	FileKey _installedStickersKey = 0;
@@ -302,6 +318,7 @@ private:
 	FileKey _featuredCustomEmojiKey = 0;
 	FileKey _archivedCustomEmojiKey = 0;
 	FileKey _searchSuggestionsKey = 0;
+	FileKey _appConfigKey = 0;
 
 	qint64 _cacheTotalSizeLimit = 0;
 	qint64 _cacheBigFileTotalSizeLimit = 0;
@@ -167,19 +167,60 @@ Domain::StartModernResult Domain::startModern(
 
 	_oldVersion = keyData.version;
 
+	struct Pending {
+		int index = 0;
+		std::unique_ptr<Main::Account> account;
+	};
 	auto tried = base::flat_set<int>();
-	auto sessions = base::flat_set<uint64>();
-	auto active = 0;
+	auto pending = std::vector<Pending>();
+	pending.reserve(count);
 	for (auto i = 0; i != count; ++i) {
 		auto index = qint32();
 		info.stream >> index;
 		if (index >= 0
 			&& index < Main::Domain::kPremiumMaxAccounts
 			&& tried.emplace(index).second) {
-			auto account = std::make_unique<Main::Account>(
-				_owner,
-				_dataName,
-				index);
+			pending.push_back({
+				.index = index,
+				.account = std::make_unique<Main::Account>(
+					_owner,
+					_dataName,
+					index),
+			});
+		} else {
+			pending.push_back({ .index = -1 });
+		}
+	}
+	auto storedActive = std::optional<qint32>();
+	if (!info.stream.atEnd()) {
+		info.stream >> storedActive.emplace();
+	}
+
+	// Read the local data of all accounts on the thread pool at once,
+	// the one that will be shown first goes to the pool first.
+	const auto prefetch = [&](const Pending &entry) {
+		if (entry.account) {
+			entry.account->local().prefetchStart(_localKey);
+		}
+	};
+	const auto activeFirst = ranges::find(
+		pending,
+		storedActive.value_or(-1),
+		&Pending::index);
+	if (activeFirst != end(pending)) {
+		prefetch(*activeFirst);
+	}
+	for (auto i = begin(pending); i != end(pending); ++i) {
+		if (i != activeFirst) {
+			prefetch(*i);
+		}
+	}
+
+	auto sessions = base::flat_set<uint64>();
+	auto active = 0;
+	for (auto i = 0; i != count; ++i) {
+		const auto index = pending[i].index;
+		if (auto account = std::move(pending[i].account)) {
 			auto config = account->prepareToStart(_localKey);
 			const auto sessionId = account->willHaveSessionUniqueId(
 				config.get());
@@ -197,13 +238,14 @@ Domain::StartModernResult Domain::startModern(
 			}
 		}
 	}
+	ClearPrefetched();
 	if (sessions.empty()) {
 		LOG(("App Error: no accounts read."));
 		return StartModernResult::Failed;
 	}
 
-	if (!info.stream.atEnd()) {
-		info.stream >> active;
+	if (storedActive) {
+		active = *storedActive;
 	}
 	_owner->activateFromStorage(active);
 
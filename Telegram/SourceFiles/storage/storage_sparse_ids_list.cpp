@@ -45,8 +45,17 @@ SparseIdsList::AddResult SparseIdsList::uniteAndAdd(
 	const auto firstToErase = uniteFrom + 1;
 	if (firstToErase != uniteTill) {
 		for (auto it = firstToErase; it != uniteTill; ++it) {
+			// Slices are erased after that, so take their ids and merge
+			// the smaller set into the larger one instead of copying.
+			auto more = base::flat_set<MsgId>();
+			_slices.modify(it, [&](Slice &slice) {
+				more = base::take(slice.messages);
+			});
 			_slices.modify(uniteFrom, [&](Slice &slice) {
-				slice.merge(it->messages, it->range);
+				if (more.size() > slice.messages.size()) {
+					std::swap(more, slice.messages);
+				}
+				slice.merge(more, it->range);
 			});
 		}
 		_slices.erase(firstToErase, uniteTill);
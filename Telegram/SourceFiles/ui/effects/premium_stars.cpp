@@ -39,6 +39,9 @@ MiniStars::MiniStars(Fn<void(const QRect &r)> updateCallback, bool opaque)
 	}
 	if (_rectToUpdate.isValid()) {
 		updateCallback(base::take(_rectToUpdate));
+	} else if (_paused && now > _lastDeathTime) {
+		// Nothing is left to fly, don't tick until unpaused.
+		_animation.stop();
 	}
 }) {
 	if (anim::Disabled()) {
@@ -125,6 +128,9 @@ void MiniStars::paint(QPainter &p, const QRectF &rect) {
 
 void MiniStars::setPaused(bool paused) {
 	_paused = paused;
+	if (!_paused && !_animation.animating() && !anim::Disabled()) {
+		_animation.start();
+	}
 }
 
 void MiniStars::createStar(crl::time now) {
@@ -149,6 +155,7 @@ void MiniStars::createStar(crl::time now) {
 		.sinFactor = randomInterval(_sinFactor, next()) / 100.
 			* ((uchar(next()) % 2) == 1 ? 1. : -1.),
 	};
+	_lastDeathTime = std::max(_lastDeathTime, ministar.deathTime);
 	for (auto i = 0; i < _ministars.size(); i++) {
 		if (ministar.birthTime > _ministars[i].deathTime) {
 			_ministars[i] = ministar;
@@ -62,6 +62,7 @@ private:
 	std::vector<MiniStar> _ministars;
 
 	crl::time _nextBirthTime = 0;
+	crl::time _lastDeathTime = 0;
 	bool _paused = false;
 
 	QRect _rectToUpdate;
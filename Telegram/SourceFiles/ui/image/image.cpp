@@ -86,11 +86,7 @@ QImage Image::original() const {
 	return _data;
 }
 
-const QPixmap &Image::cached(
-		int w,
-		int h,
-		const Images::PrepareArgs &args,
-		bool single) const {
+QSize Image::pixSize(int w, int h) const {
 	const auto ratio = style::DevicePixelRatio();
 	if (w <= 0 || !width() || !height()) {
 		w = width();
@@ -101,6 +97,18 @@ const QPixmap &Image::cached(
 		w *= ratio;
 		h *= ratio;
 	}
+	return { w, h };
+}
+
+const QPixmap &Image::cached(
+		int w,
+		int h,
+		const Images::PrepareArgs &args,
+		bool single) const {
+	const auto ratio = style::DevicePixelRatio();
+	const auto pixels = pixSize(w, h);
+	w = pixels.width();
+	h = pixels.height();
 	const auto outer = args.outer;
 	const auto size = outer.isEmpty() ? QSize(w, h) : outer * ratio;
 	const auto k = single ? SinglePixKey(args) : PixKey(w, h, args);
@@ -110,6 +118,52 @@ const QPixmap &Image::cached(
 		: _cache.emplace_or_assign(k, prepare(w, h, args)).first->second;
 }
 
+QPixmap Image::pixSingleAsync(
+		QSize size,
+		const Images::PrepareArgs &args,
+		Fn<void()> ready) const {
+	if (isNull() || args.colored) {
+		// Those are cheap or use style colors, prepare them right away.
+		return pixSingle(size, args);
+	}
+	const auto ratio = style::DevicePixelRatio();
+	const auto pixels = pixSize(size.width(), size.height());
+	const auto outer = args.outer;
+	const auto result = outer.isEmpty() ? pixels : outer * ratio;
+	const auto k = SinglePixKey(args);
+	const auto i = _cache.find(k);
+	if (i != _cache.cend() && i->second.size() == result) {
+		return i->second;
+	}
+	const auto j = _preparing.find(k);
+	if (j == _preparing.end() || j->second != pixels) {
+		_preparing[k] = pixels;
+		crl::async([=, data = _data, weak = base::make_weak(this)] {
+			auto image = Prepare(data, pixels.width(), pixels.height(), args);
+			crl::on_main([=, image = std::move(image)]() mutable {
+				const auto strong = weak.get();
+				if (!strong) {
+					return;
+				}
+				const auto i = strong->_preparing.find(k);
+				if (i == strong->_preparing.end() || i->second != pixels) {
+					// A different size was requested after this one.
+					return;
+				}
+				strong->_preparing.erase(i);
+				strong->_cache.emplace_or_assign(
+					k,
+					Ui::PixmapFromImage(std::move(image)));
+				if (ready) {
+					ready();
+				}
+			});
+		});
+	}
+	// Don't return a pixmap of another size, it would be drawn stretched.
+	return QPixmap();
+}
+
 QPixmap Image::prepare(int w, int h, const Images::PrepareArgs &args) const {
 	if (_data.isNull()) {
 		if (h <= 0 && height() > 0) {
@@ -7,11 +7,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
 #include "ui/image/image_prepare.h"
 
 class QPainterPath;
 
-class Image final {
+class Image final : public base::has_weak_ptr {
 public:
 	explicit Image(const QString &path);
 	explicit Image(const QByteArray &content);
@@ -70,6 +71,14 @@ public:
 		return cached(w, 0, args, true);
 	}
 
+	// Same as pixSingle(), but a missing pixmap is prepared on a background
+	// thread and ready() is called on main when it is cached. Meanwhile
+	// returns a null pixmap, so that the caller draws a placeholder.
+	[[nodiscard]] QPixmap pixSingleAsync(
+		QSize size,
+		const Images::PrepareArgs &args,
+		Fn<void()> ready) const;
+
 	[[nodiscard]] QPixmap pixNoCache(
 			QSize size,
 			const Images::PrepareArgs &args = {}) const {
@@ -88,6 +97,7 @@ public:
 	}
 
 private:
+	[[nodiscard]] QSize pixSize(int w, int h) const;
 	[[nodiscard]] QPixmap prepare(
 		int w,
 		int h,
@@ -100,5 +110,6 @@ private:
 
 	const QImage _data;
 	mutable base::flat_map<uint64, QPixmap> _cache;
+	mutable base::flat_map<uint64, QSize> _preparing;
 
 };
@@ -11,20 +11,20 @@ namespace PowerSaving {
 namespace {
 
 Flags Data/* = {}*/;
+Flags AutomaticData/* = {}*/;
 rpl::event_stream<> Events;
 bool AllForced/* = false*/;
 
 } // namespace
 
 void Set(Flags flags) {
-	if (const auto diff = Data ^ flags) {
-		Data = flags;
-		if (!AllForced) {
-			if (diff & kAnimations) {
-				anim::SetDisabled(On(kAnimations));
-			}
-			Events.fire({});
+	const auto diff = (Data ^ flags) & ~AutomaticData;
+	Data = flags;
+	if (diff && !AllForced) {
+		if (diff & kAnimations) {
+			anim::SetDisabled(On(kAnimations));
 		}
+		Events.fire({});
 	}
 }
 
@@ -37,7 +37,7 @@ void SetForceAll(bool force) {
 		return;
 	}
 	AllForced = force;
-	if (const auto diff = Data ^ kAll) {
+	if (const auto diff = kAll & ~(Data | AutomaticData)) {
 		if (diff & kAnimations) {
 			anim::SetDisabled(On(kAnimations));
 		}
@@ -49,6 +49,21 @@ bool ForceAll() {
 	return AllForced;
 }
 
+void SetAutomatic(Flags flags) {
+	const auto diff = (AutomaticData ^ flags) & ~Data;
+	AutomaticData = flags;
+	if (diff && !AllForced) {
+		if (diff & kAnimations) {
+			anim::SetDisabled(On(kAnimations));
+		}
+		Events.fire({});
+	}
+}
+
+Flags Automatic() {
+	return AutomaticData;
+}
+
 rpl::producer<> Changes() {
 	return Events.events();
 }
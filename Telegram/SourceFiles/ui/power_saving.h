@@ -32,10 +32,14 @@ void Set(Flags flags);
 void SetForceAll(bool force);
 [[nodiscard]] bool ForceAll();
 
+// Flags engaged temporarily by Core::PowerSavingGovernor.
+void SetAutomatic(Flags flags);
+[[nodiscard]] Flags Automatic();
+
 [[nodiscard]] rpl::producer<> Changes();
 
 [[nodiscard]] inline bool On(Flag flag) {
-	return ForceAll() || (Current() & flag);
+	return ForceAll() || (Current() & flag) || (Automatic() & flag);
 }
 [[nodiscard]] inline rpl::producer<bool> OnValue(Flag flag) {
 	return rpl::single(On(flag)) | rpl::then(Changes() | rpl::map([=] {
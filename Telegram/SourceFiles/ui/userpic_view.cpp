@@ -11,6 +11,72 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/image/image_prepare.h"
 
 namespace Ui {
+namespace {
+
+constexpr auto kSharedCacheLimit = 1024;
+
+struct SharedCacheKey {
+	qint64 cloud = 0;
+	int size = 0;
+	bool forum = false;
+	bool square = false;
+
+	friend inline auto operator<=>(
+		const SharedCacheKey &a,
+		const SharedCacheKey &b) = default;
+};
+
+// Views of the same photo of the same size in dialogs, history and
+// members lists share one rounded image instead of keeping own copies.
+base::flat_map<SharedCacheKey, QImage> SharedCache;
+
+void PruneSharedCache() {
+	for (auto i = begin(SharedCache); i != end(SharedCache);) {
+		if (i->second.isDetached()) {
+			// Nobody but the cache uses this image any more.
+			i = SharedCache.erase(i);
+		} else {
+			++i;
+		}
+	}
+	if (SharedCache.size() >= kSharedCacheLimit) {
+		SharedCache.clear();
+	}
+}
+
+[[nodiscard]] QImage PrepareRounded(const QImage &cloud, int size, bool forum) {
+	auto result = cloud.scaled(
+		QSize(size, size),
+		Qt::IgnoreAspectRatio,
+		Qt::SmoothTransformation);
+	return forum
+		? Images::Round(
+			std::move(result),
+			Images::CornersMask(size
+				* Ui::ForumUserpicRadiusMultiplier()
+				/ style::DevicePixelRatio()))
+		: Images::Circle(std::move(result));
+}
+
+[[nodiscard]] QImage SharedRounded(const QImage &cloud, int size, bool forum) {
+	const auto key = SharedCacheKey{
+		.cloud = cloud.cacheKey(),
+		.size = size,
+		.forum = forum,
+		.square = style::SquareUserpics(),
+	};
+	const auto i = SharedCache.find(key);
+	if (i != end(SharedCache)) {
+		return i->second;
+	} else if (SharedCache.size() >= kSharedCacheLimit) {
+		PruneSharedCache();
+	}
+	return SharedCache.emplace(
+		key,
+		PrepareRounded(cloud, size, forum)).first->second;
+}
+
+} // namespace
 
 float64 ForumUserpicRadiusMultiplier() {
 	return 0.3;
@@ -44,21 +110,9 @@ void ValidateUserpicCache(
 	view.paletteVersion = version;
 
 	if (cloud) {
-		view.cached = cloud->scaled(
-			full,
-			Qt::IgnoreAspectRatio,
-			Qt::SmoothTransformation);
-		if (forum) {
-			view.cached = Images::Round(
-				std::move(view.cached),
-				Images::CornersMask(size
-					* Ui::ForumUserpicRadiusMultiplier()
-					/ style::DevicePixelRatio()));
-		} else {
-			view.cached = Images::Circle(std::move(view.cached));
-		}
+		view.cached = SharedRounded(*cloud, size, forum);
 	} else {
-		if (view.cached.size() != full) {
+		if (view.cached.size() != full || !view.cached.isDetached()) {
 			view.cached = QImage(full, QImage::Format_ARGB32_Premultiplied);
 		}
 		view.cached.fill(Qt::transparent);
@@ -31,6 +31,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document_resolver.h"
 #include "data/data_download_manager.h"
 #include "data/data_session.h"
+#include "data/data_histories.h"
 #include "data/data_file_origin.h"
 #include "data/data_folder.h"
 #include "data/data_channel.h"
@@ -1632,6 +1633,20 @@ const rpl::variable<Data::Forum*> &SessionController::shownForum() const {
 }
 
 void SessionController::setActiveChatEntry(Dialogs::RowDescriptor row) {
+	const auto wasOwning = _activeChatEntry.current().key.owningHistory();
+	const auto nowOwning = row.key.owningHistory();
+	if (wasOwning != nowOwning) {
+		if (wasOwning) {
+			wasOwning->owner().histories().setOpenedInWindow(
+				wasOwning,
+				false);
+		}
+		if (nowOwning) {
+			nowOwning->owner().histories().setOpenedInWindow(
+				nowOwning,
+				true);
+		}
+	}
 	const auto was = _activeChatEntry.current().key.history();
 	const auto now = row.key.history();
 	if (was && was != now) {
@@ -2980,6 +2995,9 @@ std::shared_ptr<ChatHelpers::Show> SessionController::uiShow() {
 
 SessionController::~SessionController() {
 	resetFakeUnreadWhileOpened();
+	if (const auto history = activeChatCurrent().owningHistory()) {
+		history->owner().histories().setOpenedInWindow(history, false);
+	}
 }
 
 } // namespace Window